@@ -0,0 +1,50 @@
+if (NOT DEFINED BENCHMARK OR NOT BENCHMARK)
+    set(BENCHMARK OFF)
+    message(
+        STATUS
+            "Benchmarks disabled (Disabled by default, enabled via -DBENCHMARK=ON flag)"
+    )
+endif ()
+if (BENCHMARK)
+    message(
+        STATUS
+            "Benchmarks enabled (Disabled by default, enabled via -DBENCHMARK=ON flag)"
+    )
+endif ()
+
+# Builds the benchmark executable "benchmark<LibraryName>" from the sources at
+# benchmark/src. The classes declared in benchmark/inc get a ROOT dictionary, so
+# that the benchmarks can define their own events and processes.
+macro (ADD_LIBRARY_BENCHMARK)
+    if (BENCHMARK)
+        message(STATUS "Adding benchmarks at ${CMAKE_CURRENT_SOURCE_DIR}")
+
+        get_filename_component(DIR_NAME ${CMAKE_CURRENT_SOURCE_DIR} NAME)
+        string(SUBSTRING ${DIR_NAME} 0 1 FIRST_LETTER)
+        string(TOUPPER ${FIRST_LETTER} FIRST_LETTER)
+        string(REGEX REPLACE "^.(.*)" "${FIRST_LETTER}\\1" DIR_NAME_CAPITALIZED
+                             "${DIR_NAME}")
+
+        set(LIBRARY_NAME "Rest${DIR_NAME_CAPITALIZED}")
+
+        set(BENCHMARK_EXECUTABLE "benchmark${LIBRARY_NAME}")
+
+        file(GLOB SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/benchmark/src/*.cxx)
+        file(GLOB HEADERS ${CMAKE_CURRENT_SOURCE_DIR}/benchmark/inc/*.h)
+        list(FILTER HEADERS EXCLUDE REGEX "LinkDef\\.h$")
+
+        include_directories(${CMAKE_CURRENT_SOURCE_DIR}/benchmark/inc)
+
+        root_generate_dictionary(
+            G__${BENCHMARK_EXECUTABLE} ${HEADERS} LINKDEF
+            ${CMAKE_CURRENT_SOURCE_DIR}/benchmark/inc/LinkDef.h)
+
+        add_executable(${BENCHMARK_EXECUTABLE} ${SOURCES}
+                                               G__${BENCHMARK_EXECUTABLE}.cxx)
+
+        target_link_libraries(
+            ${BENCHMARK_EXECUTABLE} PUBLIC ${LIBRARY_NAME} RestFramework
+                                           stdc++fs # <filesystem>
+        )
+    endif ()
+endmacro ()
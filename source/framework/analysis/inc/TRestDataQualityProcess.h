@@ -23,6 +23,8 @@
 #ifndef RestCore_TRestDataQualityProcess
 #define RestCore_TRestDataQualityProcess
 
+#include <limits>
+
 #include "TRestDataQualityRules.h"
 #include "TRestEventProcess.h"
 
@@ -40,9 +42,42 @@ class TRestDataQualityProcess : public TRestEventProcess {
 
     TRestEvent* fEvent = nullptr;  //!
 
+    /// Running statistics of an observable accumulated event by event
+    struct ObservableStatistics {
+        Long64_t entries = 0;
+        Double_t sum = 0;
+        Double_t min = std::numeric_limits<Double_t>::max();
+        Double_t max = std::numeric_limits<Double_t>::lowest();
+
+        void Fill(Double_t value);
+        void Merge(const ObservableStatistics& other);
+        Double_t GetMean() const { return entries > 0 ? sum / entries : 0; }
+    };
+
+    /// The names of the observables used by the obs rules
+    std::vector<std::string> fObservableNames;  //!
+
+    /// The analysis tree index of each observable, -1 if it is not found yet
+    std::vector<Int_t> fObservableIds;  //!
+
+    /// The running statistics of each observable
+    std::vector<ObservableStatistics> fStatistics;  //!
+
+    /// For each quality number and rule, the index inside fStatistics. -1 for non-observable rules
+    std::vector<std::vector<Int_t>> fRuleObservable;  //!
+
+    /// For each quality number and rule, the number of events with the observable inside the range
+    std::vector<std::vector<Long64_t>> fRuleEntriesInRange;  //!
+
+    /// It is true once the statistics have been merged by one of the parallel processes
+    Bool_t fStatisticsMerged = false;  //!
+
     void InitProcess() override;
+    void EndOfEventProcess(TRestEvent* inputEvent = nullptr) override;
     void EndProcess() override;
 
+    void MergeParallelStatistics();
+
     void InitFromConfigFile() override;
 
     void Initialize() override;
@@ -50,6 +85,8 @@ class TRestDataQualityProcess : public TRestEventProcess {
     void LoadDefaultConfig();
 
     Bool_t EvaluateMetadataRule(TString value, TVector2 range);
+    Bool_t EvaluateObservableRule(unsigned int n, unsigned int r);
+    void PrintObservableRuleStatistics(unsigned int n, unsigned int r);
 
     /// It sets to 1 the bit of number at position `bitPosition`
     void EnableBit(UInt_t& number, Int_t bitPosition) { number |= (1u << bitPosition); }
@@ -23,6 +23,8 @@
 #ifndef REST_TRestDataSetOdds
 #define REST_TRestDataSetOdds
 
+#include <ROOT/RDataFrame.hxx>
+
 #include "TH1F.h"
 #include "TRestCut.h"
 #include "TRestMetadata.h"
@@ -61,6 +63,7 @@ class TRestDataSetOdds : public TRestMetadata {
     void PrintMetadata() override;
 
     void ComputeLogOdds();
+    ROOT::RDF::RNode DefineLogOdds(ROOT::RDF::RNode df);
 
     std::vector<std::tuple<std::string, TVector2, int>> GetOddsObservables();
     std::string GetOddsFile() { return fOddsFile; }
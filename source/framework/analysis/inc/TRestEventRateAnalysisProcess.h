@@ -23,21 +23,30 @@
 #ifndef RestCore_TRestEventRateAnalysisProcess
 #define RestCore_TRestEventRateAnalysisProcess
 
+#include <memory>
+
 #include "TRestEventProcess.h"
 
+class TRestProcessRunner;
+
 //! A pure analysis process used to calculate event rates and other time observables
 class TRestEventRateAnalysisProcess : public TRestEventProcess {
    private:
+    struct EventTimeStream;
+
     /// A pointer to the input event
     TRestEvent* fEvent;  //!
 
     /// It registers the timestamp from the first event to calculate time from start observables
     Double_t fFirstEventTime;  //!
 
-    /// It keeps a historic list of timestamps of the previous N events. Now fixed to N=10 events.
-    std::vector<Double_t> fPreviousEventTime;  //!
+    /// It keeps the times of the previous N events in reading order. Shared by the parallel processes.
+    std::shared_ptr<EventTimeStream> fTimeStream;  //!
+
+    /// The runner providing the reading order of the events under multi-thread mode
+    TRestProcessRunner* fRunner = nullptr;  //!
 
-    /// It indicates whether to add rate observables which is correct only under single thread run.
+    /// It indicates whether to add rate observables which need a globally ordered event stream.
     bool fRateAnalysis = false;  //!
 
     void Initialize() override;
@@ -51,14 +60,15 @@ class TRestEventRateAnalysisProcess : public TRestEventProcess {
 
     void InitProcess() override;
     TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+    void NotifyEntryFinished(Long64_t entry) override;
 
     void PrintMetadata() override {
         BeginPrintProcess();
 
         if (fRateAnalysis) {
-            RESTMetadata << "Rate analysis is on under single thread mode" << RESTendl;
+            RESTMetadata << "Rate analysis is on" << RESTendl;
         } else {
-            RESTMetadata << "Rate analysis is off due to multi-thread" << RESTendl;
+            RESTMetadata << "Rate analysis is off, the event reading order is not available" << RESTendl;
         }
 
         EndPrintProcess();
@@ -21,13 +21,29 @@
  *************************************************************************/
 
 //////////////////////////////////////////////////////////////////////////
-/// TRestDataQualityProcess ... TODO documentation here ...
+/// TRestDataQualityProcess defines quality numbers whose bits are enabled
+/// when the corresponding rule is found inside the given range.
 ///
+/// The following rule types are available:
+/// * **metadata**: The value of a metadata member, given as `className::member`.
+/// * **obsAverage**: The average of an observable along the processed events.
+/// * **obsMax**: The maximum value of an observable along the processed events.
+/// * **obsMin**: The minimum value of an observable along the processed events.
 ///
-/// ```
-/// A code example here
+/// The observable statistics are accumulated event by event at
+/// EndOfEventProcess, and merged from all the threads at EndProcess, so that
+/// the analysis tree does not need to be read again once the processing is
+/// finished. Therefore, only observables defined by previous processes in
+/// the chain (or the input analysis tree) can be used inside the rules.
 ///
 /// ```
+/// <TRestDataQualityProcess name="quality" >
+///     <qualityNumber name="gain" >
+///         <rule type="obsAverage" value="sAna_ThresholdIntegral" range="(1000,5000)" bit="0" />
+///         <rule type="obsMax" value="sAna_NumberOfGoodSignals" range="(0,100)" bit="1" />
+///     </qualityNumber>
+/// </TRestDataQualityProcess>
+/// ```
 ///
 ///--------------------------------------------------------------------------
 ///
@@ -39,6 +55,8 @@
 ///             Javier Galan
 ///				Oscar Perez
 ///
+/// 2026-October: Observable rules evaluated from running statistics
+///
 /// \class      TRestDataQualityProcess
 /// \author     Javier Galan
 /// \author     Oscar Perez
@@ -46,6 +64,8 @@
 /// <hr>
 ///
 #include "TRestDataQualityProcess.h"
+
+#include <algorithm>
 using namespace std;
 
 ClassImp(TRestDataQualityProcess);
@@ -109,8 +129,33 @@ void TRestDataQualityProcess::LoadConfig(const string& configFilename, const str
 /// to process the event
 ///
 void TRestDataQualityProcess::InitProcess() {
-    // For example, try to initialize a pointer to existing metadata
-    // accessible from TRestRun
+    fObservableNames.clear();
+    fObservableIds.clear();
+    fStatistics.clear();
+    fRuleObservable.clear();
+    fRuleEntriesInRange.clear();
+    fStatisticsMerged = false;
+
+    for (unsigned int n = 0; n < fRules.size(); n++) {
+        fRuleObservable.push_back(vector<Int_t>(fRules[n].GetNumberOfRules(), -1));
+        fRuleEntriesInRange.push_back(vector<Long64_t>(fRules[n].GetNumberOfRules(), 0));
+
+        for (int r = 0; r < fRules[n].GetNumberOfRules(); r++) {
+            TString type = fRules[n].GetType(r);
+            if (type != "obsAverage" && type != "obsMax" && type != "obsMin") continue;
+
+            string obsName = (string)fRules[n].GetValue(r);
+            auto it = std::find(fObservableNames.begin(), fObservableNames.end(), obsName);
+            if (it == fObservableNames.end()) {
+                fObservableNames.push_back(obsName);
+                it = fObservableNames.end() - 1;
+            }
+            fRuleObservable[n][r] = it - fObservableNames.begin();
+        }
+    }
+
+    fObservableIds.resize(fObservableNames.size(), -1);
+    fStatistics.resize(fObservableNames.size());
 }
 
 ///////////////////////////////////////////////
@@ -125,15 +170,96 @@ void TRestDataQualityProcess::Initialize() { SetSectionName(this->ClassName());
 TRestEvent* TRestDataQualityProcess::ProcessEvent(TRestEvent* inputEvent) {
     fEvent = inputEvent;
 
-    // This process does nothing at the event-by-event level
+    // The observable statistics are updated at EndOfEventProcess
 
     return fEvent;
 }
 
+///////////////////////////////////////////////
+/// \brief It updates the running statistics of the observables used by the
+/// rules with the values of the current event
+///
+void TRestDataQualityProcess::EndOfEventProcess(TRestEvent* inputEvent) {
+    TRestEventProcess::EndOfEventProcess(inputEvent);
+
+    if (fAnalysisTree == nullptr) return;
+
+    for (unsigned int i = 0; i < fObservableNames.size(); i++) {
+        // The observables of previous processes may be added after InitProcess
+        if (fObservableIds[i] == -1) fObservableIds[i] = fAnalysisTree->GetObservableID(fObservableNames[i]);
+    }
+
+    for (unsigned int n = 0; n < fRuleObservable.size(); n++) {
+        for (unsigned int r = 0; r < fRuleObservable[n].size(); r++) {
+            Int_t i = fRuleObservable[n][r];
+            if (i < 0 || fObservableIds[i] < 0) continue;
+
+            Double_t value = fAnalysisTree->GetDblObservableValue(fObservableIds[i]);
+            TVector2 range = fRules[n].GetRange(r);
+            if (value >= range.X() && value <= range.Y()) fRuleEntriesInRange[n][r]++;
+        }
+    }
+
+    for (unsigned int i = 0; i < fObservableNames.size(); i++) {
+        if (fObservableIds[i] < 0) continue;
+        fStatistics[i].Fill(fAnalysisTree->GetDblObservableValue(fObservableIds[i]));
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It adds a new observable value to the statistics
+///
+void TRestDataQualityProcess::ObservableStatistics::Fill(Double_t value) {
+    entries++;
+    sum += value;
+    if (value < min) min = value;
+    if (value > max) max = value;
+}
+
+///////////////////////////////////////////////
+/// \brief It adds the statistics accumulated by a different thread
+///
+void TRestDataQualityProcess::ObservableStatistics::Merge(const ObservableStatistics& other) {
+    entries += other.entries;
+    sum += other.sum;
+    if (other.min < min) min = other.min;
+    if (other.max > max) max = other.max;
+}
+
+///////////////////////////////////////////////
+/// \brief It merges the statistics accumulated by the parallel processes
+/// into this process
+///
+/// The parallel processes are flagged so that the rules are only evaluated
+/// once, by the first process reaching EndProcess.
+///
+void TRestDataQualityProcess::MergeParallelStatistics() {
+    for (unsigned int p = 0; p < GetNumberOfParallelProcesses(); p++) {
+        auto parallel = (TRestDataQualityProcess*)GetParallel(p);
+        if (parallel == nullptr || parallel == this) continue;
+
+        for (unsigned int i = 0; i < fStatistics.size() && i < parallel->fStatistics.size(); i++)
+            fStatistics[i].Merge(parallel->fStatistics[i]);
+
+        for (unsigned int n = 0; n < fRuleEntriesInRange.size() && n < parallel->fRuleEntriesInRange.size();
+             n++)
+            for (unsigned int r = 0; r < fRuleEntriesInRange[n].size(); r++)
+                fRuleEntriesInRange[n][r] += parallel->fRuleEntriesInRange[n][r];
+
+        parallel->fStatisticsMerged = true;
+    }
+    fStatisticsMerged = true;
+}
+
 ///////////////////////////////////////////////
 /// \brief Function to use when all events have been processed
 ///
 void TRestDataQualityProcess::EndProcess() {
+    // The rules have already been evaluated by a parallel process
+    if (fStatisticsMerged) return;
+
+    MergeParallelStatistics();
+
     /// We loop to each quality number definition
     for (unsigned int n = 0; n < fQualityNumber.size(); n++) {
         /// We loop to each rule from the quality definition
@@ -146,26 +272,23 @@ void TRestDataQualityProcess::EndProcess() {
                     DisableBit(fQualityNumber[n], fRules[n].GetBit(r));
             }
 
-            if (fRules[n].GetType(r) == "obsAverage") {
-                // TODO implementation
-            }
-
-            if (fRules[n].GetType(r) == "obsMax") {
-                // TODO implementation
+            // We implement observable-based quality numbers
+            if (fRuleObservable[n][r] >= 0) {
+                if (EvaluateObservableRule(n, r))
+                    EnableBit(fQualityNumber[n], fRules[n].GetBit(r));
+                else
+                    DisableBit(fQualityNumber[n], fRules[n].GetBit(r));
             }
         }
     }
 
-    if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Info) PrintMetadata();
+    // The parallel processes share the same quality numbers
+    for (unsigned int p = 0; p < GetNumberOfParallelProcesses(); p++) {
+        auto parallel = (TRestDataQualityProcess*)GetParallel(p);
+        if (parallel != nullptr) parallel->fQualityNumber = fQualityNumber;
+    }
 
-    ///// Just some examples accessing analysis tree
-    ///// We can get now any entry.
-    // this->GetFullAnalysisTree()->GetEntry(3);
-    // this->GetFullAnalysisTree()->PrintObservables();
-    // cout << "Nobs : " << fRunInfo->GetAnalysisTree()->GetNumberOfObservables() << endl;
-    // cout << "Entries : " << fRunInfo->GetAnalysisTree()->GetEntries() << endl;
-    // cout << "Nobs : " << this->GetFullAnalysisTree()->GetNumberOfObservables() << endl;
-    // cout << "Entries : " << this->GetFullAnalysisTree()->GetEntries() << endl;
+    if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Info) PrintMetadata();
 }
 
 ///////////////////////////////////////////////
@@ -246,6 +369,7 @@ void TRestDataQualityProcess::PrintMetadata() {
             if (isBitEnabled(fQualityNumber[n], fRules[n].GetBit(r))) {
                 RESTMetadata << fRules[n].GetValue(r) << " is in range (" << fRules[n].GetRange(r).X() << ", "
                              << fRules[n].GetRange(r).Y() << ")" << RESTendl;
+                PrintObservableRuleStatistics(n, r);
                 rulesInRange++;
             }
         if (!rulesInRange) RESTMetadata << "No rules found in range!" << RESTendl;
@@ -258,6 +382,7 @@ void TRestDataQualityProcess::PrintMetadata() {
             if (!isBitEnabled(fQualityNumber[n], fRules[n].GetBit(r))) {
                 RESTMetadata << fRules[n].GetValue(r) << " is NOT in range (" << fRules[n].GetRange(r).X()
                              << ", " << fRules[n].GetRange(r).Y() << ")" << RESTendl;
+                PrintObservableRuleStatistics(n, r);
                 rulesOutRange++;
             }
         if (!rulesOutRange) RESTMetadata << "No rules found outside range!" << RESTendl;
@@ -266,6 +391,19 @@ void TRestDataQualityProcess::PrintMetadata() {
     EndPrintProcess();
 }
 
+///////////////////////////////////////////////
+/// \brief It prints out the statistics of the observable used by the rule
+/// `r` of the quality number `n`, if any
+///
+void TRestDataQualityProcess::PrintObservableRuleStatistics(unsigned int n, unsigned int r) {
+    if (n >= fRuleObservable.size() || r >= fRuleObservable[n].size() || fRuleObservable[n][r] < 0) return;
+
+    const ObservableStatistics& stats = fStatistics[fRuleObservable[n][r]];
+    RESTMetadata << "   - " << fRules[n].GetType(r) << ". Mean : " << stats.GetMean() << ", Min : " << stats.min
+                 << ", Max : " << stats.max << ". Entries in range : " << fRuleEntriesInRange[n][r] << "/"
+                 << stats.entries << RESTendl;
+}
+
 Bool_t TRestDataQualityProcess::EvaluateMetadataRule(TString value, TVector2 range) {
     vector<string> results = REST_StringHelper::Split((string)value, "::", false, true);
 
@@ -291,3 +429,23 @@ Bool_t TRestDataQualityProcess::EvaluateMetadataRule(TString value, TVector2 ran
                   << RESTendl;
     return false;
 }
+
+Bool_t TRestDataQualityProcess::EvaluateObservableRule(unsigned int n, unsigned int r) {
+    Int_t i = fRuleObservable[n][r];
+    if (fStatistics[i].entries == 0) {
+        RESTWarning << "TRestDataQualityProcess::EvaluateObservableRule. No entries found for observable "
+                    << fObservableNames[i] << RESTendl;
+        return false;
+    }
+
+    Double_t value = 0;
+    if (fRules[n].GetType(r) == "obsAverage")
+        value = fStatistics[i].GetMean();
+    else if (fRules[n].GetType(r) == "obsMax")
+        value = fStatistics[i].max;
+    else if (fRules[n].GetType(r) == "obsMin")
+        value = fStatistics[i].min;
+
+    TVector2 range = fRules[n].GetRange(r);
+    return value >= range.X() && value <= range.Y();
+}
@@ -245,34 +245,97 @@ void TRestDataSetGainMap::CalibrateDataSet(const std::string& dataSetFileName, s
 
     auto dataFrame = dataSet.GetDataFrame();
 
-    // Define a new column with the identifier (pmID) of the module for each row (event)
+    // Define a new column with the identifier (pmID) of the module for each row (event).
+    // The module definition cuts are combined in a single expression where the last
+    // matching module takes precedence, so that only one column needs to be compiled.
     std::string pmIDname = (std::string)GetName() + "_pmID";
-    std::string modCut = fModulesCal[0].GetModuleDefinitionCut();
-    if (modCut.empty()) modCut = "1";  // if no cut is defined, use "1" (all events)
-    int pmID = fModulesCal[0].GetPlaneId() * 10 + fModulesCal[0].GetModuleId();
+    std::string pmIDexpr = "-1";
+    for (const auto& m : fModulesCal) {
+        std::string modCut = m.GetModuleDefinitionCut();
+        if (modCut.empty()) modCut = "1";  // if no cut is defined, use "1" (all events)
+        int pmID = m.GetPlaneId() * 10 + m.GetModuleId();
+        pmIDexpr = "(" + modCut + ") ? " + std::to_string(pmID) + " : (" + pmIDexpr + ")";
+    }
 
     auto columnList = dataFrame.GetColumnNames();
     if (std::find(columnList.begin(), columnList.end(), pmIDname) == columnList.end())
-        dataFrame = dataFrame.Define(pmIDname, modCut + " ? " + std::to_string(pmID) + " : -1");
+        dataFrame = dataFrame.Define(pmIDname, pmIDexpr);
     else
-        dataFrame = dataFrame.Redefine(pmIDname, modCut + " ? " + std::to_string(pmID) + " : -1");
+        dataFrame = dataFrame.Redefine(pmIDname, pmIDexpr);
+
+    // Flat lookup table with the calibration parameters of every module segment. It is
+    // built once here, so that the event loop does not need to search for the module nor
+    // access the std::set of split points for each entry.
+    struct ModuleTable {
+        std::vector<double> splitX;
+        std::vector<double> splitY;
+        size_t offset = 0;
+        size_t nY = 1;
+        double fullSlope = 0;
+        double fullIntercept = 0;
+    };
+    std::vector<ModuleTable> tables;
+    std::vector<double> slopes;
+    std::vector<double> intercepts;
+    std::vector<int> pmIDIndex;
+
+    for (const auto& m : fModulesCal) {
+        int pmID = m.GetPlaneId() * 10 + m.GetModuleId();
+        if (pmID < 0) {
+            RESTWarning << "TRestDataSetGainMap::CalibrateDataSet: Invalid pmID " << pmID
+                        << " for plane " << m.GetPlaneId() << " and module " << m.GetModuleId() << RESTendl;
+            continue;
+        }
+        if (pmID >= (int)pmIDIndex.size()) pmIDIndex.resize(pmID + 1, -1);
+        if (pmIDIndex[pmID] >= 0) continue;  // the first module with a given pmID is used
+
+        ModuleTable t;
+        t.splitX.assign(m.fSplitX.begin(), m.fSplitX.end());
+        t.splitY.assign(m.fSplitY.begin(), m.fSplitY.end());
+        t.offset = slopes.size();
+        t.fullSlope = m.GetSlopeFullSpc();
+        t.fullIntercept = m.GetInterceptFullSpc();
+
+        size_t nX = t.splitX.size() > 1 ? t.splitX.size() - 1 : 1;
+        t.nY = t.splitY.size() > 1 ? t.splitY.size() - 1 : 1;
+        if (m.fSlope.empty() || m.fIntercept.empty())
+            RESTError << "Calibration matrix of plane " << m.GetPlaneId() << " and module "
+                      << m.GetModuleId() << " is empty. Using 0" << RESTendl;
+
+        for (size_t ix = 0; ix < nX; ix++) {
+            for (size_t iy = 0; iy < t.nY; iy++) {
+                double slope = 0, intercept = 0;
+                if (ix < m.fSlope.size() && iy < m.fSlope[ix].size()) slope = m.fSlope[ix][iy];
+                if (ix < m.fIntercept.size() && iy < m.fIntercept[ix].size())
+                    intercept = m.fIntercept[ix][iy];
+                slopes.push_back(slope);
+                intercepts.push_back(intercept);
+            }
+        }
 
-    for (size_t n = 1; n < fModulesCal.size(); n++) {
-        modCut = fModulesCal[n].GetModuleDefinitionCut();
-        if (modCut.empty()) modCut = "1";  // if no cut is defined, use "1" (all events)
-        pmID = fModulesCal[n].GetPlaneId() * 10 + fModulesCal[n].GetModuleId();
-        dataFrame = dataFrame.Redefine(pmIDname, (modCut + " ? " + std::to_string(pmID) + " : " + pmIDname));
+        pmIDIndex[pmID] = tables.size();
+        tables.push_back(t);
     }
 
+    // Same segment index as given by Module::GetIndexMatrix, where positions outside the
+    // readout are assigned to the first or last segment.
+    auto segmentIndex = [](const std::vector<double>& split, double v) -> size_t {
+        if (split.size() < 2) return 0;
+        auto it = std::upper_bound(split.begin(), split.end(), v);
+        if (it == split.begin()) return 0;
+        if (it == split.end()) return split.size() - 2;
+        return std::distance(split.begin(), it) - 1;
+    };
+
     // Define a new column with the calibrated observable
-    auto calibrate = [this](double val, double x, double y, int pmID) {
-        for (auto& m : fModulesCal) {
-            if (pmID == m.GetPlaneId() * 10 + m.GetModuleId())
-                return m.GetSlope(x, y) * val + m.GetIntercept(x, y);
-        }
-        // RESTError << "TRestDataSetGainMap::CalibrateDataSet: Module not found for pmID " << pmID <<
-        // RESTendl;
-        return std::numeric_limits<double>::quiet_NaN();
+    auto calibrate = [tables, pmIDIndex, slopes, intercepts, segmentIndex](double val, double x, double y,
+                                                                            int pmID) {
+        if (pmID < 0 || pmID >= (int)pmIDIndex.size() || pmIDIndex[pmID] < 0)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        const auto& t = tables[pmIDIndex[pmID]];
+        size_t index = t.offset + segmentIndex(t.splitX, x) * t.nY + segmentIndex(t.splitY, y);
+        return slopes[index] * val + intercepts[index];
     };
     std::string calibObsName = (std::string)GetName() + "_";
     calibObsName += GetObservable().erase(0, GetObservable().find("_") + 1);  // remove the "rawAna_" part
@@ -280,14 +343,12 @@ void TRestDataSetGainMap::CalibrateDataSet(const std::string& dataSetFileName, s
                                  {fObservable, fSpatialObservableX, fSpatialObservableY, pmIDname});
 
     // Define a new column with the calibrated observable for the whole module calibration
-    auto calibrateFullSpc = [this](double val, int pmID) {
-        for (auto& m : fModulesCal) {
-            if (pmID == m.GetPlaneId() * 10 + m.GetModuleId())
-                return m.GetSlopeFullSpc() * val + m.GetInterceptFullSpc();
-        }
-        // RESTError << "TRestDataSetGainMap::CalibrateDataSet: Module not found for pmID " << pmID <<
-        // RESTendl;
-        return std::numeric_limits<double>::quiet_NaN();
+    auto calibrateFullSpc = [tables, pmIDIndex](double val, int pmID) {
+        if (pmID < 0 || pmID >= (int)pmIDIndex.size() || pmIDIndex[pmID] < 0)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        const auto& t = tables[pmIDIndex[pmID]];
+        return t.fullSlope * val + t.fullIntercept;
     };
     std::string calibObsNameFullSpc = (std::string)GetName() + "_";
     calibObsNameFullSpc +=
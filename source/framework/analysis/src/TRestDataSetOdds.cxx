@@ -102,6 +102,8 @@
 
 #include "TRestDataSetOdds.h"
 
+#include <algorithm>
+
 #include "TRestDataSet.h"
 
 ClassImp(TRestDataSetOdds);
@@ -201,6 +203,9 @@ void TRestDataSetOdds::InitFromConfigFile() {
 /// odds_obsName and the addition of all of them for a further
 /// processing, which is stored in odds_total observable.
 ///
+/// The PDFs of all the observables are filled in a single loop
+/// over the dataset.
+///
 void TRestDataSetOdds::ComputeLogOdds() {
     PrintMetadata();
 
@@ -210,6 +215,10 @@ void TRestDataSetOdds::ComputeLogOdds() {
     if (fOddsFile.empty()) {
         auto DF = dataSet.MakeCut(fCut);
         RESTInfo << "Generating PDFs for dataset: " << fDataSetName << RESTendl;
+
+        // All the histograms are booked before any of them is accessed, so that
+        // RDataFrame fills them in the same event loop
+        std::vector<ROOT::RDF::RResultPtr<TH1D>> histos;
         for (size_t i = 0; i < fObsName.size(); i++) {
             const std::string obsName = fObsName[i];
             const TVector2 range = fObsRange[i];
@@ -217,12 +226,15 @@ void TRestDataSetOdds::ComputeLogOdds() {
             const int nBins = fObsNbins[i];
             RESTDebug << "\tGenerating PDF for " << obsName << " with range: (" << range.X() << ", "
                       << range.Y() << ") and nBins: " << nBins << RESTendl;
-            auto histo =
-                DF.Histo1D({histName.c_str(), histName.c_str(), nBins, range.X(), range.Y()}, obsName);
-            TH1F* h = static_cast<TH1F*>(histo->DrawClone());
+            histos.push_back(
+                DF.Histo1D({histName.c_str(), histName.c_str(), nBins, range.X(), range.Y()}, obsName));
+        }
+
+        for (size_t i = 0; i < fObsName.size(); i++) {
+            TH1F* h = static_cast<TH1F*>(histos[i]->DrawClone());
             RESTDebug << "\tNormalizing by integral = " << h->Integral() << RESTendl;
             h->Scale(1. / h->Integral());
-            fHistos[obsName] = h;
+            fHistos[fObsName[i]] = h;
         }
     } else {
         TFile* f = TFile::Open(fOddsFile.c_str());
@@ -239,24 +251,77 @@ void TRestDataSetOdds::ComputeLogOdds() {
         }
     }
 
-    auto df = dataSet.GetDataFrame();
-    std::string totName = "";
     RESTDebug << "Computing log odds from " << fDataSetName << RESTendl;
+    dataSet.SetDataFrame(DefineLogOdds(dataSet.GetDataFrame()));
+
+    if (!fOutputFileName.empty()) {
+        if (TRestTools::GetFileNameExtension(fOutputFileName) == "root") {
+            RESTDebug << "Exporting dataset to " << fOutputFileName << RESTendl;
+            dataSet.Export(fOutputFileName);
+            TFile* f = TFile::Open(fOutputFileName.c_str(), "UPDATE");
+            this->Write();
+            RESTDebug << "Writing histograms to " << fOutputFileName << RESTendl;
+            for (const auto& [obsName, histo] : fHistos) histo->Write();
+            f->Close();
+        }
+    }
+}
+
+/////////////////////////////////////////////
+/// \brief It defines the log odds columns, odds_obsName and odds_total, on the
+/// given data frame using the PDFs previously obtained by
+/// TRestDataSetOdds::ComputeLogOdds. No event loop is triggered, so that the log odds
+/// of a whole dataset can be produced in the same pass as any other operation booked
+/// on the data frame, e.g. an export or a selection.
+///
+/// The log odds of each PDF bin are precomputed in a flat array, which is accessed
+/// arithmetically for histograms with uniform binning.
+///
+ROOT::RDF::RNode TRestDataSetOdds::DefineLogOdds(ROOT::RDF::RNode df) {
+    std::string totName = "";
     for (const auto& [obsName, histo] : fHistos) {
+        if (histo == nullptr) {
+            RESTError << "PDF for observable " << obsName << " is not available" << RESTendl;
+            continue;
+        }
+
         const std::string oddsName = "odds_" + obsName;
-        auto GetLogOdds = [&histo = histo](double val) {
-            double odds = histo->GetBinContent(histo->GetXaxis()->FindBin(val));
-            if (odds == 0) return 1000.;
-            return log(1. - odds) - log(odds);
-        };
+
+        // The log odds for each bin, including underflow (0) and overflow (nBins+1)
+        const TAxis* axis = histo->GetXaxis();
+        const int nBins = axis->GetNbins();
+        std::vector<double> logOdds(nBins + 2);
+        for (int n = 0; n < nBins + 2; n++) {
+            double odds = histo->GetBinContent(n);
+            logOdds[n] = odds == 0 ? 1000. : log(1. - odds) - log(odds);
+        }
 
         if (df.GetColumnType(obsName) != "Double_t") {
             RESTWarning << "Column " << obsName << " is not of type 'double'. It will be converted."
                         << RESTendl;
             df = df.Redefine(obsName, "static_cast<double>(" + obsName + ")");
         }
-        df = df.Define(oddsName, GetLogOdds, {obsName});
-        auto h = df.Histo1D(oddsName);
+
+        const double xMin = axis->GetXmin();
+        const double xMax = axis->GetXmax();
+        if (axis->IsVariableBinSize()) {
+            std::vector<double> edges(axis->GetXbins()->GetArray(),
+                                      axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+            auto GetLogOdds = [logOdds, edges](double val) {
+                return logOdds[std::upper_bound(edges.begin(), edges.end(), val) - edges.begin()];
+            };
+            df = df.Define(oddsName, GetLogOdds, {obsName});
+        } else {
+            const double scale = nBins / (xMax - xMin);
+            auto GetLogOdds = [logOdds, xMin, xMax, scale, nBins](double val) {
+                // same as TAxis::FindBin, which puts NaN in the overflow bin
+                if (val < xMin) return logOdds[0];
+                if (!(val < xMax)) return logOdds[nBins + 1];
+                int bin = 1 + (int)((val - xMin) * scale);
+                return logOdds[bin > nBins ? nBins : bin];
+            };
+            df = df.Define(oddsName, GetLogOdds, {obsName});
+        }
 
         if (!totName.empty()) totName += "+";
         totName += oddsName;
@@ -264,21 +329,9 @@ void TRestDataSetOdds::ComputeLogOdds() {
 
     RESTDebug << "Computing total log odds" << RESTendl;
     RESTDebug << "\tTotal log odds = " << totName << RESTendl;
-    df = df.Define("odds_total", totName);
-
-    dataSet.SetDataFrame(df);
+    if (!totName.empty()) df = df.Define("odds_total", totName);
 
-    if (!fOutputFileName.empty()) {
-        if (TRestTools::GetFileNameExtension(fOutputFileName) == "root") {
-            RESTDebug << "Exporting dataset to " << fOutputFileName << RESTendl;
-            dataSet.Export(fOutputFileName);
-            TFile* f = TFile::Open(fOutputFileName.c_str(), "UPDATE");
-            this->Write();
-            RESTDebug << "Writing histograms to " << fOutputFileName << RESTendl;
-            for (const auto& [obsName, histo] : fHistos) histo->Write();
-            f->Close();
-        }
-    }
+    return df;
 }
 
 std::vector<std::tuple<std::string, TVector2, int>> TRestDataSetOdds::GetOddsObservables() {
@@ -53,6 +53,12 @@
 /// * **MeanRate_InHz**: It records the mean rate using the last 10 events. It
 /// divides 10 by the time in seconds between the first and the last entry.
 ///
+/// The previous events are taken in the order they are read from the input.
+/// Under multi-thread mode each event waits for the events read before it
+/// to be registered by the parallel processes (or to be discarded by a
+/// previous process in the chain), so that the observables are the same as
+/// the ones obtained in single thread mode.
+///
 ///
 /// You may add filters to any observable inside the analysis tree. To add a cut,
 /// write "cut" sections in your rml file:
@@ -83,6 +89,9 @@
 ///
 /// 2022-February: Transfering rate observables from TRestRawSignalAnalysisProcess
 ///
+/// 2026-October: Rate observables computed from the globally ordered event stream
+///               under multi-thread mode
+///
 /// \class      TRestEventRateAnalysisProcess
 /// \author     Javier Galan
 ///
@@ -90,11 +99,124 @@
 ///
 #include "TRestEventRateAnalysisProcess.h"
 
+#include <array>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
 #include "TRestDataBase.h"
+#include "TRestManager.h"
+#include "TRestProcessRunner.h"
 using namespace std;
 
 ClassImp(TRestEventRateAnalysisProcess);
 
+///////////////////////////////////////////////
+/// \brief The stream of event times in reading order.
+///
+/// The times of the previous events are kept in a fixed size ring buffer. Under
+/// multi-thread mode the events are registered together with their position in
+/// the reading sequence, and they are consumed from the stream in that order.
+///
+struct TRestEventRateAnalysisProcess::EventTimeStream {
+    /// Number of previous events used to calculate the mean rate
+    static constexpr size_t kWindow = 10;
+
+    struct Result {
+        Double_t firstTime = -1;
+        Double_t timeDelay = 0;
+        Double_t meanRate = 0;
+    };
+
+    std::array<Double_t, kWindow> window{};
+    size_t count = 0;
+    size_t head = 0;
+    Double_t firstTime = -1;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    Long64_t nextEntry = 0;
+    std::map<Long64_t, Double_t> pending;
+    std::map<Long64_t, Result> results;
+
+    void Reset(Double_t startTime) {
+        count = 0;
+        head = 0;
+        firstTime = startTime;
+        nextEntry = 0;
+        pending.clear();
+        results.clear();
+    }
+
+    /// It adds the next event time of the stream and returns its observables
+    Result Push(Double_t time) {
+        Result r;
+        if (firstTime == -1) firstTime = time;
+        r.firstTime = firstTime;
+
+        if (count > 0) r.timeDelay = time - window[(head + count - 1) % kWindow];
+        if (count == kWindow) r.meanRate = kWindow / (time - window[head]);
+
+        if (count < kWindow) {
+            window[(head + count) % kWindow] = time;
+            count++;
+        } else {
+            window[head] = time;
+            head = (head + 1) % kWindow;
+        }
+        return r;
+    }
+
+    /// It consumes the registered events in reading order. The entries that finished
+    /// the process chain without being registered were discarded by a previous process.
+    bool Advance(const TRestProcessRunner* runner) {
+        bool advanced = false;
+        Long64_t firstUnfinished = -1;
+        while (true) {
+            if (!pending.empty() && pending.begin()->first == nextEntry) {
+                results[nextEntry] = Push(pending.begin()->second);
+                pending.erase(pending.begin());
+                nextEntry++;
+                advanced = true;
+                continue;
+            }
+
+            if (firstUnfinished < 0) firstUnfinished = runner->GetFirstUnfinishedEntry();
+            if (nextEntry >= firstUnfinished) break;
+
+            nextEntry = pending.empty() ? firstUnfinished : min(firstUnfinished, pending.begin()->first);
+        }
+        return advanced;
+    }
+
+    /// It registers the event at the given position of the reading sequence and waits
+    /// until all the events read before it have been consumed
+    Result PushOrdered(Long64_t entry, Double_t time, const TRestProcessRunner* runner) {
+        unique_lock<std::mutex> lock(mutex);
+        pending[entry] = time;
+
+        while (true) {
+            if (Advance(runner)) cv.notify_all();
+
+            auto it = results.find(entry);
+            if (it != results.end()) {
+                Result r = it->second;
+                results.erase(it);
+                return r;
+            }
+            // woken up by Advance() or EntryFinished()
+            cv.wait(lock);
+        }
+    }
+
+    /// It wakes up the events waiting for the entries read before them. The thread releases the entry
+    /// before calling it, and takes the mutex so that no waiting event misses the notification.
+    void EntryFinished() {
+        { lock_guard<std::mutex> lock(mutex); }
+        cv.notify_all();
+    }
+};
+
 ///////////////////////////////////////////////
 /// \brief Default constructor
 ///
@@ -114,15 +236,17 @@ void TRestEventRateAnalysisProcess::Initialize() {
 
     fEvent = NULL;
 
-    fSingleThreadOnly = true;
-
     fFirstEventTime = -1;
-    fPreviousEventTime.clear();
+    fTimeStream = nullptr;
+    fRunner = nullptr;
 }
 
 ///////////////////////////////////////////////
 /// \brief Process initialization.
 ///
+/// Under multi-thread mode the event time stream is shared by all the
+/// parallel processes.
+///
 void TRestEventRateAnalysisProcess::InitProcess() {
     if (fRunInfo != NULL && fRunInfo->GetStartTimestamp() != 0) {
         fFirstEventTime = fRunInfo->GetStartTimestamp();
@@ -130,8 +254,30 @@ void TRestEventRateAnalysisProcess::InitProcess() {
         fFirstEventTime = -1;
     }
 
-    // if is run under single thread mode, we add rate observables
-    fRateAnalysis = GetNumberOfParallelProcesses() <= 1;
+    fRunner = nullptr;
+    if (fHostmgr != nullptr && fHostmgr->GetProcessRunner() != nullptr &&
+        fHostmgr->GetProcessRunner()->GetNThreads() > 1)
+        fRunner = fHostmgr->GetProcessRunner();
+
+    bool singleThread =
+        GetNumberOfParallelProcesses() <= 1 && (GetParallel(0) == nullptr || GetParallel(0) == this);
+
+    // InitProcess is called sequentially for all the threads before any event is processed, so the
+    // first instance creates the stream and the others pick it up from their parallel processes
+    if (fTimeStream == nullptr && fRunner != nullptr) {
+        for (unsigned int n = 0; n < GetNumberOfParallelProcesses(); n++) {
+            auto parallel = (TRestEventRateAnalysisProcess*)GetParallel(n);
+            if (parallel != nullptr && parallel->fTimeStream != nullptr) {
+                fTimeStream = parallel->fTimeStream;
+                break;
+            }
+        }
+    }
+    if (fTimeStream == nullptr) fTimeStream = make_shared<EventTimeStream>();
+    fTimeStream->Reset(fFirstEventTime);
+
+    // under multi-thread mode the rate observables require the reading order of the events
+    fRateAnalysis = singleThread || fRunner != nullptr;
 }
 
 ///////////////////////////////////////////////
@@ -140,33 +286,43 @@ void TRestEventRateAnalysisProcess::InitProcess() {
 TRestEvent* TRestEventRateAnalysisProcess::ProcessEvent(TRestEvent* inputEvent) {
     fEvent = inputEvent;
 
-    if (fFirstEventTime == -1) fFirstEventTime = fEvent->GetTime();
+    EventTimeStream::Result r;
+    if (fRunner != nullptr) {
+        // During the test run the reading order is not defined yet
+        if (fInputEntry >= 0) {
+            r = fTimeStream->PushOrdered(fInputEntry, fEvent->GetTime(), fRunner);
+        } else {
+            if (fFirstEventTime == -1) fFirstEventTime = fEvent->GetTime();
+            r.firstTime = fFirstEventTime;
+        }
+    } else {
+        r = fTimeStream->Push(fEvent->GetTime());
+    }
 
-    Double_t secondsFromStart = fEvent->GetTime() - fFirstEventTime;
+    Double_t secondsFromStart = fEvent->GetTime() - r.firstTime;
     SetObservableValue("SecondsFromStart", secondsFromStart);
     SetObservableValue("HoursFromStart", secondsFromStart / 3600.);
 
     if (fRateAnalysis) {
-        Double_t evTimeDelay = 0;
-        if (fPreviousEventTime.size() > 0) evTimeDelay = fEvent->GetTime() - fPreviousEventTime.back();
-        SetObservableValue("EventTimeDelay", evTimeDelay);
-
-        Double_t meanRate = 0;
-        if (fPreviousEventTime.size() == 10)
-            meanRate = 10. / (fEvent->GetTime() - fPreviousEventTime.front());
-        SetObservableValue("MeanRate_InHz", meanRate);
+        SetObservableValue("EventTimeDelay", r.timeDelay);
+        SetObservableValue("MeanRate_InHz", r.meanRate);
 
         if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Debug) {
             for (auto i : fObservablesDefined) {
                 fAnalysisTree->PrintObservable(i.second);
             }
         }
-
-        fPreviousEventTime.push_back(fEvent->GetTimeStamp());
-        if (fPreviousEventTime.size() > 10) fPreviousEventTime.erase(fPreviousEventTime.begin());
     }
     // If cut condition matches the event will be not registered.
     if (ApplyCut()) return NULL;
 
     return fEvent;
 }
+
+///////////////////////////////////////////////
+/// \brief Under multi-thread mode, it wakes up the events waiting for this entry to be
+/// consumed or skipped by the shared event time stream
+///
+void TRestEventRateAnalysisProcess::NotifyEntryFinished(Long64_t entry) {
+    if (fRunner != nullptr && fTimeStream != nullptr) fTimeStream->EntryFinished();
+}
@@ -0,0 +1,5 @@
+#ifdef __ROOTCLING__
+#pragma link C++ class TRestBenchmarkEvent + ;
+#pragma link C++ class TRestBenchmarkSourceProcess + ;
+#pragma link C++ class TRestBenchmarkLoadProcess + ;
+#endif
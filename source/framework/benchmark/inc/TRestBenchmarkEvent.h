@@ -0,0 +1,49 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestBenchmark_TRestBenchmarkEvent
+#define RestBenchmark_TRestBenchmarkEvent
+
+#include <vector>
+
+#include "TRestEvent.h"
+
+//! A synthetic event holding a list of values, used by the framework benchmarks
+class TRestBenchmarkEvent : public TRestEvent {
+   protected:
+    /// The values in the event
+    std::vector<Double_t> fValues;
+
+   public:
+    inline void AddValue(Double_t value) { fValues.push_back(value); }
+    inline const std::vector<Double_t>& GetValues() const { return fValues; }
+    inline size_t GetNumberOfValues() const { return fValues.size(); }
+
+    void Initialize() override;
+    void PrintEvent() const override;
+
+    TRestBenchmarkEvent();
+    ~TRestBenchmarkEvent();
+
+    ClassDefOverride(TRestBenchmarkEvent, 1);
+};
+#endif
@@ -0,0 +1,54 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestBenchmark_TRestBenchmarkLoadProcess
+#define RestBenchmark_TRestBenchmarkLoadProcess
+
+#include "TRestBenchmarkEvent.h"
+#include "TRestEventProcess.h"
+
+//! A process doing a fixed amount of work on each TRestBenchmarkEvent, used by the framework benchmarks
+class TRestBenchmarkLoadProcess : public TRestEventProcess {
+   private:
+    TRestBenchmarkEvent* fEvent;  //!
+
+    /// The number of passes over the event values done for each event
+    Int_t fPasses = 1;
+
+    void Initialize() override;
+
+   public:
+    RESTValue GetInputEvent() const override { return fEvent; }
+    RESTValue GetOutputEvent() const override { return fEvent; }
+
+    TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+
+    void PrintMetadata() override;
+
+    const char* GetProcessName() const override { return "benchmarkLoad"; }
+
+    TRestBenchmarkLoadProcess();
+    ~TRestBenchmarkLoadProcess();
+
+    ClassDefOverride(TRestBenchmarkLoadProcess, 1);
+};
+#endif
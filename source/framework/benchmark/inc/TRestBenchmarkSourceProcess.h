@@ -0,0 +1,66 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestBenchmark_TRestBenchmarkSourceProcess
+#define RestBenchmark_TRestBenchmarkSourceProcess
+
+#include <TRandom3.h>
+
+#include "TRestBenchmarkEvent.h"
+#include "TRestEventProcess.h"
+
+//! An external process generating synthetic TRestBenchmarkEvent events, used by the framework benchmarks
+class TRestBenchmarkSourceProcess : public TRestEventProcess {
+   private:
+    TRestBenchmarkEvent* fOutputEvent;  //!
+    TRandom3* fRandom;                  //!
+    Int_t fGeneratedEvents;             //!
+
+    /// The number of events to generate
+    Int_t fNumberOfEvents = 10000;
+    /// The number of values in each generated event
+    Int_t fNumberOfValues = 100;
+    /// The seed of the random generator
+    Int_t fSeed = 1;
+
+    void Initialize() override;
+
+   public:
+    RESTValue GetInputEvent() const override { return RESTValue((TRestEvent*)nullptr); }
+    RESTValue GetOutputEvent() const override { return fOutputEvent; }
+
+    Bool_t OpenInputFiles(const std::vector<std::string>& files) override { return true; }
+    Bool_t ResetEntry() override;
+
+    void InitProcess() override;
+    TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+
+    void PrintMetadata() override;
+
+    const char* GetProcessName() const override { return "benchmarkSource"; }
+
+    TRestBenchmarkSourceProcess();
+    ~TRestBenchmarkSourceProcess();
+
+    ClassDefOverride(TRestBenchmarkSourceProcess, 1);
+};
+#endif
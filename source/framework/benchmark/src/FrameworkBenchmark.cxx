@@ -0,0 +1,267 @@
+//////////////////////////////////////////////////////////////////////////
+///
+/// Benchmarks of the framework hot paths, on synthetic data.
+///
+/// Built with `-DBENCHMARK=ON` as `benchmarkRestFramework`. Each benchmark prints
+/// one JSON line with its name, the number of iterations and the time spent, so
+/// the results of two releases can be compared with any script:
+///
+/// \code
+/// {"benchmark": "Event/CloneTo", "iterations": 100000, "seconds": 0.41, "nsPerIteration": 4100}
+/// \endcode
+///
+/// Options:
+/// * `-f <filter>`: run only the benchmarks whose name contains `filter`
+/// * `-s <scale>`: scale the number of iterations of all the benchmarks
+/// * `-o <file>`: write the result lines to `file` instead of the standard output
+/// * `-d <directory>`: directory for the temporary files. Default: a folder in the system temp path
+///
+/// The process runner benchmark runs a TRestBenchmarkSourceProcess +
+/// TRestBenchmarkLoadProcess chain for 1, 2, 4... threads. Its output files are
+/// the input of the TRestDataSet benchmark.
+///
+//////////////////////////////////////////////////////////////////////////
+
+#include <TFile.h>
+#include <TRandom3.h>
+#include <TRestAnalysisTree.h>
+#include <TRestDataSet.h>
+#include <TRestHits.h>
+#include <TRestManager.h>
+#include <TRestMesh.h>
+#include <TRestProcessRunner.h>
+#include <TRestTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "TRestBenchmarkEvent.h"
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+namespace {
+string gFilter;
+double gScale = 1;
+ostream* gResults = &cout;
+fs::path gWorkDir;
+
+bool Selected(const string& name) { return gFilter.empty() || name.find(gFilter) != string::npos; }
+
+Long64_t Iterations(Long64_t n) { return max<Long64_t>(1, (Long64_t)(n * gScale)); }
+
+void Report(const string& name, Long64_t iterations, double seconds, const string& extra = "") {
+    *gResults << "{\"benchmark\": \"" << name << "\", \"iterations\": " << iterations
+              << ", \"seconds\": " << seconds << ", \"nsPerIteration\": " << seconds * 1e9 / iterations
+              << extra << "}" << endl;
+}
+
+template <typename F>
+void Measure(const string& name, Long64_t iterations, F&& body, const string& extra = "") {
+    if (!Selected(name)) return;
+
+    auto start = chrono::steady_clock::now();
+    for (Long64_t i = 0; i < iterations; i++) body(i);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    Report(name, iterations, elapsed.count(), extra);
+}
+
+// a few random walks, so that the hits are clustered as in a real track
+TRestHits MakeHits(Int_t nTracks, Int_t nSteps) {
+    TRandom3 random(1);
+    TRestHits hits;
+    for (int t = 0; t < nTracks; t++) {
+        TVector3 position(random.Uniform(-30, 30), random.Uniform(-30, 30), random.Uniform(-30, 30));
+        for (int s = 0; s < nSteps; s++) {
+            position += TVector3(random.Gaus(0, 1), random.Gaus(0, 1), random.Gaus(0, 1));
+            hits.AddHit(position, random.Exp(1));
+        }
+    }
+    return hits;
+}
+
+void BenchmarkAnalysisTree() {
+    Long64_t nEntries = Iterations(1000000);
+
+    TFile file((gWorkDir / "analysisTree.root").c_str(), "recreate");
+    TRestAnalysisTree tree("AnalysisTree", "AnalysisTree");
+    TRandom3 random(1);
+
+    Measure("AnalysisTree/SetObservableValueAndFill", nEntries, [&](Long64_t) {
+        tree.SetObservableValue("gaus", random.Gaus(100, 20));
+        tree.SetObservableValue("poisson", (int)random.Poisson(36));
+        tree.SetObservableValue("rndm", random.Rndm());
+        tree.SetObservableValue("landau", random.Landau(10, 2));
+        tree.Fill();
+    });
+
+    Measure("AnalysisTree/Fill", nEntries, [&](Long64_t) { tree.Fill(); });
+
+    double gaus = 0, rndm = 0, landau = 0;
+    int poisson = 0;
+    Measure("AnalysisTree/SetObservableAndFill", nEntries, [&](Long64_t) {
+        gaus = random.Gaus(100, 20);
+        poisson = random.Poisson(36);
+        rndm = random.Rndm();
+        landau = random.Landau(10, 2);
+        tree.SetObservable("gaus", RESTValue(gaus));
+        tree.SetObservable("poisson", RESTValue(poisson));
+        tree.SetObservable("rndm", RESTValue(rndm));
+        tree.SetObservable("landau", RESTValue(landau));
+        tree.Fill();
+    });
+    tree.Write();
+
+    Long64_t entries = tree.GetEntries();
+    Measure("AnalysisTree/GetEntryAndEvaluateCuts", entries, [&](Long64_t n) {
+        tree.GetEntry(n);
+        tree.EvaluateCuts("gaus>100&&poisson<40");
+    });
+
+    Measure("AnalysisTree/GetObservableAverage", Iterations(10),
+            [&](Long64_t) { tree.GetObservableAverage("gaus"); });
+
+    file.Close();
+}
+
+void BenchmarkEvent() {
+    TRestBenchmarkEvent from, to;
+    TRandom3 random(1);
+    for (int n = 0; n < 1000; n++) from.AddValue(random.Gaus(100, 20));
+
+    Measure("Event/CloneTo", Iterations(100000), [&](Long64_t) { from.CloneTo(&to); },
+            ", \"values\": 1000");
+}
+
+void BenchmarkHits() {
+    TRestHits hits = MakeHits(5, 200);
+    TVector3 x0(-20, -20, -20), x1(20, 20, 20);
+    string extra = ", \"hits\": " + to_string(hits.GetNumberOfHits());
+
+    Measure("Hits/GetMeanPosition", Iterations(100000), [&](Long64_t) { hits.GetMeanPosition(); }, extra);
+    Measure("Hits/GetMaximumHitDistance", Iterations(100), [&](Long64_t) { hits.GetMaximumHitDistance(); },
+            extra);
+    Measure("Hits/GetClosestHit", Iterations(10000), [&](Long64_t) { hits.GetClosestHit(x0); }, extra);
+    Measure("Hits/GetEnergyInCylinder", Iterations(10000),
+            [&](Long64_t) { hits.GetEnergyInCylinder(x0, x1, 10); }, extra);
+    Measure("Hits/GetGaussSigmaX", Iterations(100), [&](Long64_t) { hits.GetGaussSigmaX(); }, extra);
+    Measure("Hits/GetGaussSigmaX/fast", Iterations(100),
+            [&](Long64_t) { hits.GetGaussSigmaX(150, 100000, true); }, extra);
+    Measure("Hits/SortByEnergy", Iterations(1000),
+            [&](Long64_t) {
+                TRestHits unsorted = hits;
+                unsorted.SortByEnergy();
+            },
+            extra);
+}
+
+void BenchmarkMesh() {
+    TRestHits hits = MakeHits(5, 200);
+
+    Measure("Mesh/SetNodesFromHits", Iterations(100),
+            [&](Long64_t) {
+                TRestMesh mesh(TVector3(100, 100, 100), TVector3(-50, -50, -50), 50, 50, 50);
+                mesh.SetNodesFromHits(&hits);  // it calls TRestMesh::Regrouping()
+            },
+            ", \"hits\": " + to_string(hits.GetNumberOfHits()));
+}
+
+void BenchmarkProcessRunner() {
+    const string name = "ProcessRunner/Throughput";
+    if (!Selected(name)) return;
+
+    Long64_t nEvents = Iterations(20000);
+    int maxThreads = min(max((int)thread::hardware_concurrency(), 1), 15);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        fs::path rml = gWorkDir / ("processRunner_" + to_string(threads) + ".rml");
+        fs::path output = gWorkDir / ("benchmarkRun_" + to_string(threads) + ".root");
+        ofstream rmlFile(rml);
+        rmlFile << "<TRestManager name=\"benchmark\" verboseLevel=\"silent\">\n"
+                << "  <TRestRun name=\"benchmark\" verboseLevel=\"silent\">\n"
+                << "    <parameter name=\"runNumber\" value=\"" << threads << "\"/>\n"
+                << "    <parameter name=\"runTag\" value=\"benchmark\"/>\n"
+                << "    <parameter name=\"outputFileName\" value=\"" << output.string() << "\"/>\n"
+                << "  </TRestRun>\n"
+                << "  <TRestProcessRunner name=\"benchmark\" verboseLevel=\"silent\">\n"
+                << "    <parameter name=\"eventsToProcess\" value=\"" << nEvents << "\"/>\n"
+                << "    <parameter name=\"threadNumber\" value=\"" << threads << "\"/>\n"
+                << "    <parameter name=\"usePauseMenu\" value=\"false\"/>\n"
+                << "    <parameter name=\"inputEventStorage\" value=\"false\"/>\n"
+                << "    <parameter name=\"outputEventStorage\" value=\"false\"/>\n"
+                << "    <addProcess type=\"TRestBenchmarkSourceProcess\" name=\"source\" "
+                << "numberOfEvents=\"" << nEvents << "\" numberOfValues=\"100\"/>\n"
+                << "    <addProcess type=\"TRestBenchmarkLoadProcess\" name=\"load\" passes=\"10\" "
+                << "observable=\"all\"/>\n"
+                << "  </TRestProcessRunner>\n"
+                << "</TRestManager>\n";
+        rmlFile.close();
+
+        TRestManager manager;
+        manager.LoadConfigFromFile(rml.string());
+
+        auto start = chrono::steady_clock::now();
+        manager.GetProcessRunner()->RunProcess();
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        Report(name, nEvents, elapsed.count(), ", \"threads\": " + to_string(threads));
+    }
+}
+
+void BenchmarkDataSet() {
+    const string name = "DataSet/GenerateDataSet";
+    if (!Selected(name)) return;
+
+    string pattern = (gWorkDir / "benchmarkRun_*.root").string();
+    if (TRestTools::GetFilesMatchingPattern(pattern).empty()) {
+        cerr << name << " skipped: it needs the output files of ProcessRunner/Throughput" << endl;
+        return;
+    }
+
+    Measure(name, Iterations(3), [&](Long64_t) {
+        TRestDataSet dataSet;
+        dataSet.SetFilePattern(pattern);
+        dataSet.SetObservablesList({"load_*"});
+        dataSet.GenerateDataSet();
+    });
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    gVerbose = TRestStringOutput::REST_Verbose_Level::REST_Silent;
+    gWorkDir = fs::temp_directory_path() / "restFrameworkBenchmark";
+
+    ofstream resultsFile;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "-f") {
+            gFilter = argv[i + 1];
+        } else if (option == "-s") {
+            gScale = stod(argv[i + 1]);
+        } else if (option == "-o") {
+            resultsFile.open(argv[i + 1]);
+            gResults = &resultsFile;
+        } else if (option == "-d") {
+            gWorkDir = argv[i + 1];
+        } else {
+            cerr << "Unknown option: " << option << endl;
+            cerr << "Usage: " << argv[0] << " [-f filter] [-s scale] [-o output] [-d directory]" << endl;
+            return 1;
+        }
+    }
+    fs::create_directories(gWorkDir);
+
+    BenchmarkAnalysisTree();
+    BenchmarkEvent();
+    BenchmarkHits();
+    BenchmarkMesh();
+    BenchmarkProcessRunner();
+    BenchmarkDataSet();
+
+    return 0;
+}
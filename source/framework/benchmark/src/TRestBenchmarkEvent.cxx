@@ -0,0 +1,59 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+///
+/// A synthetic event holding a list of double values. It is only built with
+/// the framework benchmarks, where it is generated by TRestBenchmarkSourceProcess
+/// and consumed by TRestBenchmarkLoadProcess.
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation
+///
+/// \class      TRestBenchmarkEvent
+///
+/// <hr>
+///
+#include "TRestBenchmarkEvent.h"
+
+using namespace std;
+
+ClassImp(TRestBenchmarkEvent);
+
+TRestBenchmarkEvent::TRestBenchmarkEvent() { Initialize(); }
+
+TRestBenchmarkEvent::~TRestBenchmarkEvent() {}
+
+void TRestBenchmarkEvent::Initialize() {
+    TRestEvent::Initialize();
+    fValues.clear();
+}
+
+void TRestBenchmarkEvent::PrintEvent() const {
+    TRestEvent::PrintEvent();
+    cout << "Number of values : " << fValues.size() << endl;
+}
@@ -0,0 +1,98 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+///
+/// A process standing for a typical analysis process in the benchmarks of the
+/// process runner. It goes `passes` times over the values of each
+/// TRestBenchmarkEvent and stores a few statistics as observables. It should be
+/// added with `observable="all"`.
+///
+/// \code
+/// <addProcess type="TRestBenchmarkLoadProcess" name="load" passes="1" observable="all"/>
+/// \endcode
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation
+///
+/// \class      TRestBenchmarkLoadProcess
+///
+/// <hr>
+///
+#include "TRestBenchmarkLoadProcess.h"
+
+#include <TMath.h>
+
+using namespace std;
+
+ClassImp(TRestBenchmarkLoadProcess);
+
+TRestBenchmarkLoadProcess::TRestBenchmarkLoadProcess() { Initialize(); }
+
+TRestBenchmarkLoadProcess::~TRestBenchmarkLoadProcess() {}
+
+void TRestBenchmarkLoadProcess::Initialize() {
+    SetSectionName(this->ClassName());
+
+    fEvent = nullptr;
+}
+
+TRestEvent* TRestBenchmarkLoadProcess::ProcessEvent(TRestEvent* inputEvent) {
+    fEvent = (TRestBenchmarkEvent*)inputEvent;
+
+    const vector<Double_t>& values = fEvent->GetValues();
+    Double_t sum = 0, sum2 = 0, max = 0;
+    for (int p = 0; p < fPasses; p++) {
+        sum = 0;
+        sum2 = 0;
+        max = values.empty() ? 0 : values[0];
+        for (const auto& v : values) {
+            sum += v;
+            sum2 += v * v;
+            if (v > max) max = v;
+        }
+    }
+
+    Double_t mean = values.empty() ? 0 : sum / values.size();
+    Double_t rms = values.empty() ? 0 : TMath::Sqrt(TMath::Max(0., sum2 / values.size() - mean * mean));
+
+    SetObservableValue("sum", sum);
+    SetObservableValue("mean", mean);
+    SetObservableValue("rms", rms);
+    SetObservableValue("max", max);
+    SetObservableValue("nValues", (int)values.size());
+
+    return fEvent;
+}
+
+void TRestBenchmarkLoadProcess::PrintMetadata() {
+    BeginPrintProcess();
+
+    RESTMetadata << "Passes over the event values : " << fPasses << RESTendl;
+
+    EndPrintProcess();
+}
@@ -0,0 +1,102 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+///
+/// An external process generating `numberOfEvents` synthetic TRestBenchmarkEvent
+/// events with `numberOfValues` gaussian values each. It feeds the process
+/// runner benchmarks without the need of any input file.
+///
+/// \code
+/// <addProcess type="TRestBenchmarkSourceProcess" name="source" numberOfEvents="10000"
+///             numberOfValues="100" seed="1"/>
+/// \endcode
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation
+///
+/// \class      TRestBenchmarkSourceProcess
+///
+/// <hr>
+///
+#include "TRestBenchmarkSourceProcess.h"
+
+using namespace std;
+
+ClassImp(TRestBenchmarkSourceProcess);
+
+TRestBenchmarkSourceProcess::TRestBenchmarkSourceProcess() { Initialize(); }
+
+TRestBenchmarkSourceProcess::~TRestBenchmarkSourceProcess() {
+    delete fOutputEvent;
+    delete fRandom;
+}
+
+void TRestBenchmarkSourceProcess::Initialize() {
+    SetSectionName(this->ClassName());
+
+    fOutputEvent = new TRestBenchmarkEvent();
+    fRandom = nullptr;
+    fGeneratedEvents = 0;
+    fIsExternal = true;
+}
+
+void TRestBenchmarkSourceProcess::InitProcess() {
+    delete fRandom;
+    fRandom = new TRandom3(fSeed);
+    fGeneratedEvents = 0;
+}
+
+Bool_t TRestBenchmarkSourceProcess::ResetEntry() {
+    fGeneratedEvents = 0;
+    if (fRandom != nullptr) fRandom->SetSeed(fSeed);
+    return true;
+}
+
+TRestEvent* TRestBenchmarkSourceProcess::ProcessEvent(TRestEvent* inputEvent) {
+    if (fGeneratedEvents >= fNumberOfEvents) return nullptr;
+
+    fOutputEvent->Initialize();
+    fOutputEvent->SetID(fGeneratedEvents);
+    fOutputEvent->SetTime(fGeneratedEvents);
+    for (int n = 0; n < fNumberOfValues; n++) {
+        fOutputEvent->AddValue(fRandom->Gaus(100, 20));
+    }
+
+    fGeneratedEvents++;
+    return fOutputEvent;
+}
+
+void TRestBenchmarkSourceProcess::PrintMetadata() {
+    BeginPrintProcess();
+
+    RESTMetadata << "Number of events : " << fNumberOfEvents << RESTendl;
+    RESTMetadata << "Number of values : " << fNumberOfValues << RESTendl;
+    RESTMetadata << "Random seed : " << fSeed << RESTendl;
+
+    EndPrintProcess();
+}
@@ -27,6 +27,7 @@
 #include <TTree.h>
 
 #include <limits>
+#include <unordered_map>
 
 #include "TRestEvent.h"
 #include "TRestReflector.h"
@@ -42,14 +43,14 @@ class TRestAnalysisTree : public TTree {
     Int_t fSubRunOrigin;    //!
 
     //
-    Int_t fStatus = 0;                                  //!
-    Int_t fSetObservableCalls = 0;                      //!
-    Int_t fSetObservableIndex = 0;                      //!
-    Bool_t fQuickSetObservableValue = true;             //!
-    std::vector<RESTValue> fObservables;                //!
-    std::map<std::string, int> fObservableIdMap;        //!
-    std::map<std::string, int> fObservableIdSearchMap;  //! used for quick search of certain observables
-    TChain* fChain = nullptr;                           //! in case multiple files for reading
+    Int_t fStatus = 0;                                            //!
+    Int_t fSetObservableCalls = 0;                                //!
+    Int_t fSetObservableIndex = 0;                                //!
+    Bool_t fQuickSetObservableValue = true;                       //!
+    std::vector<RESTValue> fObservables;                          //!
+    std::unordered_map<std::string, int> fObservableIdMap;        //!
+    std::unordered_map<std::string, int> fObservableIdSearchMap;  //! results of GetMatchedObservableID()
+    TChain* fChain = nullptr;                                     //! in case multiple files for reading
 
     // for storage
     Int_t fNObservables;
@@ -63,6 +64,8 @@ class TRestAnalysisTree : public TTree {
     void UpdateBranches();
     void InitObservables();
     void MakeObservableIdMap();
+    void PrepareForReading();
+    TBranch* GetObservableBranch(Int_t id);
     void ReadLeafValueToObservable(TLeaf* lf, RESTValue& obs);
     bool BranchesExist() { return GetListOfBranches()->GetEntriesFast() > 0; }
 
@@ -252,6 +255,8 @@ class TRestAnalysisTree : public TTree {
 
     void SetEventInfo(TRestAnalysisTree* tree);
     void SetEventInfo(TRestEvent* evt);
+    void SetEventInfo(Int_t runOrigin, Int_t subRunOrigin, Int_t eventID, Int_t subEventID,
+                      Double_t timeStamp, const TString& subEventTag);
     Int_t Fill();
 
     RESTValue AddObservable(const TString& observableName, const TString& observableType = "double",
@@ -276,6 +281,9 @@ class TRestAnalysisTree : public TTree {
     void EnableAllBranches();
     void DisableAllBranches();
 
+    std::vector<Bool_t> EnableOnlyBranches(const std::vector<std::string>& obsNames);
+    void RestoreBranchStatus(const std::vector<Bool_t>& status);
+
     void EnableQuickObservableValueSetting();
     void DisableQuickObservableValueSetting();
 
@@ -319,6 +327,7 @@ class TRestAnalysisTree : public TTree {
     Int_t WriteAsTTree(const char* name = 0, Int_t option = 0, Int_t bufsize = 0);
 
     Bool_t AddChainFile(const std::string& file);
+    Bool_t AppendChainFile(const std::string& file, Long64_t entries = TTree::kMaxEntries);
 
     TTree* GetTree() const;
 
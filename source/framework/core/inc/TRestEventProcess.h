@@ -84,6 +84,8 @@ class TRestEventProcess : public TRestMetadata {
     bool fDynamicObs = false;  //!
     /// It defines if observable names should be added to the validation list
     bool fValidateObservables = false;  //!
+    /// Position of the event being processed in the reading sequence of the run. -1 if undefined.
+    Long64_t fInputEntry = -1;  //!
     /// Stores the list of process observables updated when processing this event
     std::map<std::string, int> fObservablesUpdated;  //!     [name, id in AnalysisTree]
     /// Stores the list of all the appeared process observables in the code
@@ -216,6 +218,7 @@ class TRestEventProcess : public TRestMetadata {
     virtual Bool_t ResetEntry() { return false; }
 
     inline void SetObservableValidation(bool validate) { fValidateObservables = validate; }
+    inline void SetInputEntry(Long64_t entry) { fInputEntry = entry; }
 
     inline void RegisterAllObservables(Bool_t value = true) { fDynamicObs = value; }
 
@@ -244,6 +247,9 @@ class TRestEventProcess : public TRestMetadata {
     void SetParallelProcess(TRestEventProcess* p);
     /// In case the analysis tree is reset(switched to new file), some process needs to have action
     virtual void NotifyAnalysisTreeReset() {}
+    /// Called when the event at the given position of the reading sequence has left the process chain,
+    /// after being written, cut or discarded by any of the processes
+    virtual void NotifyEntryFinished(Long64_t entry) {}
 
     // getters
     /// Get pointer to input event. Must be implemented in the derived class
@@ -49,7 +49,7 @@ class TRestGDMLParser : public TRestMetadata {
 
     void ReplaceEntity();
 
-    void ReplaceAttributeWithKeyWord(const std::string& keyword);
+    void ReplaceAttributeExpressions();
 
     ClassDefOverride(TRestGDMLParser, 2);
 };
@@ -31,7 +31,9 @@
 #include <TMatrixD.h>
 #include <TVector3.h>
 
+#include <functional>
 #include <iostream>
+#include <vector>
 
 enum REST_HitType { unknown = -1, X = 2, Y = 3, Z = 5, XY = 6, XZ = 10, YZ = 15, XYZ = 30, VETO = 100 };
 
@@ -61,7 +63,35 @@ class TRestHits {
     /// The type of hit X,Y,XY,XYZ, ...
     std::vector<REST_HitType> fType;
 
+    /// It reorders `column` so that its element `i` is the former element `order[i]`
+    template <typename T>
+    static void PermuteColumn(std::vector<T>& column, const std::vector<size_t>& order) {
+        if (column.size() != order.size()) return;
+        std::vector<T> permuted(order.size());
+        for (size_t i = 0; i < order.size(); i++) permuted[i] = column[order[i]];
+        column.swap(permuted);
+    }
+
+    /// It removes in a single pass the elements of `column` flagged in `remove`
+    template <typename T>
+    static void RemoveFromColumn(std::vector<T>& column, const std::vector<Bool_t>& remove) {
+        if (column.size() != remove.size()) return;
+        size_t kept = 0;
+        for (size_t i = 0; i < column.size(); i++) {
+            if (!remove[i]) column[kept++] = column[i];
+        }
+        column.resize(kept);
+    }
+
+    virtual void MergeHitInto(size_t target, size_t source);
+
+    Double_t FitGaussSigma(const std::vector<Float_t>& position, Double_t error, Int_t nHitsMin) const;
+    Double_t EstimateGaussSigma(const std::vector<Float_t>& position, Double_t error, Int_t nHitsMin) const;
+
    public:
+    /// The hit quantities that can be used as sorting key
+    enum SortKey { kSortByX, kSortByY, kSortByZ, kSortByTime, kSortByEnergy };
+
     void Translate(Int_t n, Double_t x, Double_t y, Double_t z);
     void RotateIn3D(Int_t n, Double_t alpha, Double_t beta, Double_t gamma, const TVector3& center);
     void Rotate(Int_t n, Double_t alpha, const TVector3& vAxis, const TVector3& vMean);
@@ -79,6 +109,11 @@ class TRestHits {
     virtual void SwapHits(Int_t i, Int_t j);
     virtual void RemoveHit(int n);
 
+    virtual void RemoveHitsByMask(const std::vector<Bool_t>& remove);
+    void RemoveHitsIf(const std::function<Bool_t(size_t)>& predicate);
+    void MergeHitPairs(const std::vector<std::pair<size_t, size_t>>& pairs);
+    void MergeHitClusters(const std::vector<Int_t>& labels);
+
     virtual Bool_t areXY() const;
     virtual Bool_t areXZ() const;
     virtual Bool_t areYZ() const;
@@ -90,6 +125,12 @@ class TRestHits {
 
     Bool_t isSortedByEnergy() const;
 
+    std::vector<size_t> GetSortingPermutation(SortKey key, Bool_t descending = false,
+                                              Bool_t stable = false) const;
+    virtual void ApplyPermutation(const std::vector<size_t>& order);
+    void Sort(SortKey key, Bool_t descending = false, Bool_t stable = false);
+    void SortByEnergy(Bool_t stable = false);
+
     inline size_t GetNumberOfHits() const { return fEnergy.size(); }
 
     inline const std::vector<Float_t>& GetX() const { return fX; }
@@ -124,9 +165,9 @@ class TRestHits {
     Double_t GetSkewXY() const;
     Double_t GetSkewZ() const;
 
-    Double_t GetGaussSigmaX(Double_t error = 150.0, Int_t nHitsMin = 100000);
-    Double_t GetGaussSigmaY(Double_t error = 150.0, Int_t nHitsMin = 100000);
-    Double_t GetGaussSigmaZ(Double_t error = 150.0, Int_t nHitsMin = 100000);
+    Double_t GetGaussSigmaX(Double_t error = 150.0, Int_t nHitsMin = 100000, Bool_t fast = false);
+    Double_t GetGaussSigmaY(Double_t error = 150.0, Int_t nHitsMin = 100000, Bool_t fast = false);
+    Double_t GetGaussSigmaZ(Double_t error = 150.0, Int_t nHitsMin = 100000, Bool_t fast = false);
 
     Double_t GetEnergyX() const;
     Double_t GetEnergyY() const;
@@ -73,11 +73,26 @@ class TRestManager;
 //! A base class for any REST metadata class
 class TRestMetadata : public TNamed {
    private:
+    /// The variable of a for loop being expanded, linked to the ones of the enclosing loops
+    struct ForLoopScope {
+        std::string name;
+        std::string value;
+        const ForLoopScope* parent = nullptr;
+
+        /// It returns the value of the innermost loop variable called `variable`, or nullptr
+        const std::string* Find(const std::string& variable) const {
+            for (const ForLoopScope* scope = this; scope != nullptr; scope = scope->parent) {
+                if (scope->name == variable) return &scope->value;
+            }
+            return nullptr;
+        }
+    };
+
     void ReadEnvInElement(TiXmlElement* e, bool overwrite = true);
     void ReadElement(TiXmlElement* e, bool recursive = false);
-    void ReplaceForLoopVars(TiXmlElement* e, std::map<std::string, std::string> forLoopVar);
-    void ExpandForLoopOnce(TiXmlElement* e, const std::map<std::string, std::string>& forLoopVar);
-    void ExpandForLoops(TiXmlElement* e, std::map<std::string, std::string> forLoopVar);
+    void ReplaceForLoopVars(TiXmlElement* e, const ForLoopScope* scope);
+    void ExpandForLoopOnce(TiXmlElement* e, const ForLoopScope* scope);
+    void ExpandForLoops(TiXmlElement* e, const ForLoopScope* parentScope = nullptr);
     void ExpandIfSections(TiXmlElement* e);
     void ExpandIncludeFile(TiXmlElement* e);
     std::string GetUnits(TiXmlElement* e);
@@ -321,6 +336,8 @@ class TRestMetadata : public TNamed {
 
     TVector3 Get3DVectorParameterWithUnits(std::string parName, TVector3 defaultValue = TVector3(-1, -1, -1));
 
+    Bool_t CheckParameterUnits(const std::string& parName, const std::string& expectedUnits);
+
     /// If this method is called the metadata information will **not** be stored in disk.
     void DoNotStore() { fStore = false; }
     /// If this method is called the metadata information will be stored in disk.
@@ -1,6 +1,8 @@
 #ifndef RestCore_TRestProcessRunner
 #define RestCore_TRestProcessRunner
 
+#include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -44,6 +46,20 @@ class TRestProcessRunner : public TRestMetadata {
     ProcStatus fProcStatus;            //!
     Int_t fNBranches;                  //!
     Int_t fNFilesSplit;                //! Number of files being split.
+    std::vector<std::thread> fSplitFileWriters;  //! Threads closing the files split away from
+
+    /// A precomputed list of copies between two sets of observables
+    struct ObservableCopyPlan;
+    std::vector<ObservableCopyPlan> fThreadCopyPlans;  //! From each thread analysis tree to the output one
+    std::vector<std::vector<TRestEvent*>> fThreadEventObjects;  //! The event tree objects of each thread
+    std::vector<TRestEvent*> fEventTreeObjects;  //! The objects the output event tree branches point to
+
+    /// A copy of the output of a thread, waiting to be written in reading order
+    struct OutputSlot;
+    std::vector<std::unique_ptr<OutputSlot>> fOutputSlots;  //! The slots allocated for sorted output
+    std::vector<OutputSlot*> fFreeOutputSlots;              //! The slots available for new copies
+    std::map<Long64_t, OutputSlot*> fPendingOutput;  //! The copies waiting, by input entry. nullptr if cut
+    Long64_t fNextOutputEntry;                       //! The next input entry to be written
 
     // metadata
     Bool_t fUseTestRun;
@@ -54,6 +70,7 @@ class TRestProcessRunner : public TRestMetadata {
     Bool_t fInputEventStorage;
     Bool_t fOutputEventStorage;
     Bool_t fOutputAnalysisStorage;
+    Bool_t fParallelCompression;  // compress the output baskets with ROOT implicit multi-threading
     Int_t fThreadNumber;
     Int_t fProcessNumber;
     Int_t fFirstEntry;
@@ -95,11 +112,19 @@ class TRestProcessRunner : public TRestMetadata {
     void ReadProcInfo();
     void RunProcess();
     void PauseMenu();
-    Int_t GetNextevtFunc(TRestEvent* targetevt, TRestAnalysisTree* targettree);
+    void SetProcStatus(ProcStatus status);
+    Int_t GetNextevtFunc(TRestEvent* targetevt, TRestAnalysisTree* targettree,
+                         TRestThread* thread = nullptr);
     void FillThreadEventFunc(TRestThread* t);
+    void WriteThreadEvent(TRestThread* t);
+    void WriteOutputSlot(OutputSlot* slot);
+    void WritePendingOutput();
+    void FillOutputTrees();
     void ConfigOutputFile();
     void MergeOutputFile();
-    void WriteProcessesMetadata();
+    void WriteProcessesMetadata(TFile* file = nullptr);
+    static void CloseSplitFile(TFile* file);
+    void JoinSplitFileWriters();
 
     // tools
     void ResetRunTimes();
@@ -118,6 +143,7 @@ class TRestProcessRunner : public TRestMetadata {
     inline int GetNThreads() const { return fThreadNumber; }
     inline int GetNProcesses() const { return fProcessNumber; }
     inline int GetNProcessedEvents() const { return fProcessedEvents; }
+    Long64_t GetFirstUnfinishedEntry() const;
     double GetReadingSpeed();
     bool UseTestRun() const { return fUseTestRun; }
     inline ProcStatus GetStatus() const { return fProcStatus; }
@@ -127,7 +153,7 @@ class TRestProcessRunner : public TRestMetadata {
     TRestProcessRunner();
     ~TRestProcessRunner();
 
-    ClassDefOverride(TRestProcessRunner, 7);
+    ClassDefOverride(TRestProcessRunner, 8);
 };
 
 #endif
@@ -59,6 +59,10 @@ class TRestRun : public TRestMetadata {
     int fEventIndexCounter = 0;            //!
     bool fHangUpEndFile = false;           //!
     bool fFromRML = false;                 //!
+    bool fChainInputFiles = false;         //! read all the input files as a single input
+    std::vector<Long64_t> fInputFileFirstEntries;  //! first input entry of each chained input file
+    std::vector<Long64_t> fInputFileEntries;       //! number of input entries of each chained input file
+    std::vector<Int_t> fInputFileRunNumbers;       //! run number of each chained input file
 
     Long64_t fFeminosDaqTotalEvents = 0;  //!
 
@@ -78,6 +82,7 @@ class TRestRun : public TRestMetadata {
     void ReadFileInfo(const std::string& filename);
     void ReadInputFileMetadata();
     void ReadInputFileTrees();
+    void ChainInputFiles();
 
     void ResetEntry();
 
@@ -94,6 +99,8 @@ class TRestRun : public TRestMetadata {
 
     TString FormFormat(const TString& filenameFormat);
     TFile* MergeToOutputFile(std::vector<std::string> fileFullNames, std::string outputFileName = "");
+    static Bool_t MergeFiles(const std::vector<std::string>& files, const std::string& outputFileName,
+                             Int_t nThreads = 1);
     TFile* FormOutputFile();
     TFile* UpdateOutputFile();
 
@@ -170,6 +177,9 @@ class TRestRun : public TRestMetadata {
     inline TRestAnalysisTree* GetAnalysisTree() const { return fAnalysisTree; }
     inline TTree* GetEventTree() const { return fEventTree; }
     inline Int_t GetInputFileNumber() const { return fFileProcess == nullptr ? fInputFileNames.size() : 1; }
+    Int_t GetInputRunNumber(Long64_t entry) const;
+    Int_t GetInputFileIndex(Long64_t entry) const;
+    std::pair<Long64_t, Long64_t> GetInputFileEntryRange(Int_t n) const;
 
     std::vector<std::string> GetEventTypesList();
 
@@ -216,6 +226,7 @@ class TRestRun : public TRestMetadata {
     inline void SetHistoricMetadataSaving(bool save) { fSaveHistoricData = save; }
     inline void SetNFilesSplit(int n) { fNFilesSplit = n; }
     inline void HangUpEndFile() { fHangUpEndFile = true; }
+    inline void SetChainInputFiles(bool chain) { fChainInputFiles = chain; }
     inline void ReleaseEndFile() { fHangUpEndFile = false; }
 
     inline void SetFeminosDaqTotalEvents(Long64_t n) { fFeminosDaqTotalEvents = n; }
@@ -30,7 +30,9 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #ifdef REST_UnitsAdd_Caller
 #define AddUnit(name, type, scale) double name = _AddUnit(#name, type, scale)
@@ -51,9 +53,13 @@ class TRestSystemOfUnits {
     // stores a list of units order for composite units
     std::vector<double> fComponentOrder;
 
-    Bool_t fZombie;
+    Bool_t fZombie = true;
 
-    double fScaleCombined;
+    double fScaleCombined = 1;
+
+    TRestSystemOfUnits() = default;
+    /// Parse the unit definition, without using the cache
+    void Parse(std::string unitsStr);
 
     /// Get the type of the units
     int GetUnitType(std::string singleUnit);
@@ -63,9 +69,13 @@ class TRestSystemOfUnits {
    public:
     /// Constructor from a unit std::string
     TRestSystemOfUnits(std::string unitsStr);
+    /// Returns the parsed units, shared by all the calls with the same unit std::string
+    static std::shared_ptr<const TRestSystemOfUnits> Get(const std::string& unitsStr);
     /// Whether this unit is zombie(invalid)
     bool IsZombie() const { return fZombie; }
-    std::string ToStandardDefinition();
+    std::string ToStandardDefinition() const;
+    std::map<int, double> GetDimension() const;
+    bool HasSameDimension(const TRestSystemOfUnits& units) const;
 
     friend Double_t operator*(const Double_t& val, const TRestSystemOfUnits& units) {
         if (units.fZombie) return val;
@@ -80,6 +90,7 @@ class TRestSystemOfUnits {
 
 bool IsBasicUnit(std::string in);
 bool IsUnit(std::string in);
+bool AreCompatibleUnits(std::string unitsA, std::string unitsB);
 
 double GetScaleToStandardUnit(std::string unitsdef);
 std::string GetStandardUnitDefinition(std::string unitsdef);
@@ -9,6 +9,7 @@
 #include <TString.h>
 #include <TTree.h>
 
+#include <atomic>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -34,6 +35,7 @@ class TRestThread {
     TTree* fEventTree;                              //!
 
     std::thread t;                                        //!
+    std::atomic<Long64_t> fInputEntry;                    //!
     Bool_t isFinished;                                    //!
     Bool_t fProcessNullReturned;                          //!
     Int_t fCompressionLevel;                              //!
@@ -50,6 +52,7 @@ class TRestThread {
     void ProcessEvent();
     void EndProcess();
     void StartThread();
+    void JoinThread();
 
     Int_t ValidateChain(TRestEvent* input);
 
@@ -59,8 +62,10 @@ class TRestThread {
     inline void SetProcessRunner(TRestProcessRunner* r) { fHostRunner = r; }
     inline void SetCompressionLevel(Int_t comp) { fCompressionLevel = comp; }
     inline void SetVerboseLevel(TRestStringOutput::REST_Verbose_Level verb) { fVerboseLevel = verb; }
+    inline void SetInputEntry(Long64_t entry) { fInputEntry = entry; }
 
     inline Int_t GetThreadId() const { return fThreadId; }
+    inline Long64_t GetInputEntry() const { return fInputEntry; }
     inline TRestEvent* GetInputEvent() { return fInputEvent; }
     inline TFile* GetOutputFile() { return fOutputFile; };
     inline TRestEvent* GetOutputEvent() { return fProcessNullReturned ? 0 : fOutputEvent; }
@@ -73,7 +78,7 @@ class TRestThread {
 
     // Constructor & Destructor
     TRestThread() { Initialize(); }
-    ~TRestThread(){};
+    ~TRestThread() { JoinThread(); }
 };
 
 #endif
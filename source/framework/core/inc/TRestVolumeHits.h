@@ -33,6 +33,8 @@ class TRestVolumeHits : public TRestHits {
     std::vector<Float_t> fSigmaY;  // [fNHits] Sigma on Y axis for each volume hit (units microms)
     std::vector<Float_t> fSigmaZ;  // [fNHits] Sigma on Z axis for each volume hit (units microms)
 
+    void MergeHitInto(size_t target, size_t source);
+
    public:
     void AddHit(Double_t x, Double_t y, Double_t z, Double_t en, Double_t time, REST_HitType type,
                 Double_t sigmaX, Double_t sigmaY, Double_t sigmaZ);
@@ -40,11 +42,11 @@ class TRestVolumeHits : public TRestHits {
     void AddHit(const TRestVolumeHits& hits, Int_t n);
 
     void RemoveHits();
-    void MergeHits(Int_t n, Int_t m);
 
     void RemoveHit(int n);
-    void SortByEnergy();
+    void RemoveHitsByMask(const std::vector<Bool_t>& remove);
     void SwapHits(Int_t i, Int_t j);
+    void ApplyPermutation(const std::vector<size_t>& order);
 
     Bool_t areXY() const;
     Bool_t areXZ() const;
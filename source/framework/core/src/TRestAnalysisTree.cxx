@@ -184,26 +184,29 @@ Int_t TRestAnalysisTree::GetMatchedObservableID(const string& obsName) {
     if (iter != fObservableIdSearchMap.end()) {
         return iter->second;
     } else {
-        vector<int> diffs;
-        for (auto& fObservableName : fObservableNames) {
-            string obs = (string)fObservableName;
-            int diff1 = DiffString(obs, obsName);
-
-            obs = obs.substr(obs.find('_') + 1, -1);
-            int diff2 = DiffString(obs, obsName);
-
-            diffs.push_back(min(diff1, diff2));
-        }
-
+        // the observable name, or the name without its "xxx_" prefix, must be obsName. Otherwise the
+        // closest name within 2 characters is suggested
+        const int maxDiff = 2;
         int matchedCount = 0;
         int minPos = 0;
-        int min = 1e5;
-        for (unsigned int i = 0; i < diffs.size(); i++) {
-            if (min > diffs[i]) {
-                min = diffs[i];
+        int minDiff = maxDiff + 1;
+        for (unsigned int i = 0; i < fObservableNames.size() && matchedCount < 2; i++) {
+            const string_view obs(fObservableNames[i].Data(), fObservableNames[i].Length());
+            const string_view obsNoPrefix = obs.substr(obs.find('_') + 1);
+
+            int diff = 0;
+            if (obs != obsName && obsNoPrefix != obsName) {
+                // once an exact match is found, only the other exact matches matter
+                diff = minDiff == 0 ? maxDiff + 1
+                                    : min(DiffString(obs, obsName, maxDiff),
+                                          DiffString(obsNoPrefix, obsName, maxDiff));
+            }
+
+            if (diff < minDiff) {
+                minDiff = diff;
                 minPos = i;
             }
-            if (diffs[i] == 0) {
+            if (diff == 0) {
                 matchedCount++;
             }
         }
@@ -215,7 +218,7 @@ Int_t TRestAnalysisTree::GetMatchedObservableID(const string& obsName) {
             return minPos;
         } else if (matchedCount == 0) {
             RESTError << "TRestAnalysisTree::GetObservableID(): No Matching observable found" << RESTendl;
-            if (min <= 2) {
+            if (minDiff <= maxDiff) {
                 RESTError << "did you mean \"" << fObservableNames[minPos] << "\" ?" << RESTendl;
                 fObservableIdSearchMap[obsName] = -1;
                 return -1;
@@ -380,6 +383,39 @@ void TRestAnalysisTree::UpdateObservables() {
     fStatus = EvaluateStatus();
 }
 
+namespace {
+using BranchMaker = TBranch* (*)(TTree*, const char*, char*);
+
+template <typename T>
+TBranch* MakeBranch(TTree* tree, const char* name, char* address) {
+    return tree->Branch(name, (T*)address);
+}
+
+// indexed by REST_Reflection::DataTypeTag, nullptr for the types branched by class name
+const BranchMaker observableBranchMakers[REST_Reflection::kNumberOfTypeTags] = {
+    nullptr,                          // kUnknownType
+    &MakeBranch<char>,                // kCharType
+    &MakeBranch<short>,               // kShortType
+    &MakeBranch<int>,                 // kIntType
+    &MakeBranch<long>,                // kLongType
+    &MakeBranch<long long>,           // kLongLongType
+    &MakeBranch<bool>,                // kBoolType
+    &MakeBranch<float>,               // kFloatType
+    &MakeBranch<double>,              // kDoubleType
+    &MakeBranch<long double>,         // kLongDoubleType
+    &MakeBranch<unsigned char>,       // kUCharType
+    &MakeBranch<unsigned short>,      // kUShortType
+    &MakeBranch<unsigned int>,        // kUIntType
+    &MakeBranch<unsigned long>,       // kULongType
+    &MakeBranch<unsigned long long>,  // kULongLongType
+    nullptr,                          // kStringType
+    nullptr,                          // kVectorIntType
+    nullptr,                          // kVectorFloatType
+    nullptr,                          // kVectorDoubleType
+    nullptr,                          // kClassType
+};
+}  // namespace
+
 ///////////////////////////////////////////////
 /// \brief Update branches in the tree.
 ///
@@ -388,6 +424,9 @@ void TRestAnalysisTree::UpdateObservables() {
 /// first loop of observable setting. After branch creation, this method will
 /// change status 1->4, or stay 4.
 ///
+/// The branches of the basic type observables are created through a table indexed
+/// by the type tag of the observable, instead of comparing the type names.
+///
 void TRestAnalysisTree::UpdateBranches() {
     if (!GetBranch("runOrigin")) Branch("runOrigin", &fRunOrigin);
     if (!GetBranch("subRunOrigin")) Branch("subRunOrigin", &fSubRunOrigin);
@@ -403,34 +442,9 @@ void TRestAnalysisTree::UpdateBranches() {
 
         TBranch* branch = GetBranch(brName);
         if (branch == nullptr) {
-            if (typeName == "double") {
-                this->Branch(brName, (double*)ref);
-            } else if (typeName == "float") {
-                this->Branch(brName, (float*)ref);
-            } else if (typeName == "long double") {
-                this->Branch(brName, (long double*)ref);
-            } else if (typeName == "bool") {
-                this->Branch(brName, (bool*)ref);
-            } else if (typeName == "char") {
-                this->Branch(brName, (char*)ref);
-            } else if (typeName == "int") {
-                this->Branch(brName, (int*)ref);
-            } else if (typeName == "short") {
-                this->Branch(brName, (short*)ref);
-            } else if (typeName == "unsigned char") {
-                this->Branch(brName, (unsigned char*)ref);
-            } else if (typeName == "unsigned int") {
-                this->Branch(brName, (unsigned int*)ref);
-            } else if (typeName == "unsigned short") {
-                this->Branch(brName, (unsigned short*)ref);
-            } else if (typeName == "long") {
-                this->Branch(brName, (long*)ref);
-            } else if (typeName == "long long") {
-                this->Branch(brName, (long long*)ref);
-            } else if (typeName == "unsigned long") {
-                this->Branch(brName, (unsigned long*)ref);
-            } else if (typeName == "unsigned long long") {
-                this->Branch(brName, (unsigned long long*)ref);
+            BranchMaker maker = observableBranchMakers[fObservables[n].tag];
+            if (maker != nullptr) {
+                maker(this, brName, ref);
             } else {
                 this->Branch(brName, typeName, ref);
             }
@@ -459,6 +473,7 @@ void TRestAnalysisTree::InitObservables() {
 void TRestAnalysisTree::MakeObservableIdMap() {
     if (fObservableIdMap.size() != fObservableNames.size()) {
         fObservableIdMap.clear();
+        fObservableIdSearchMap.clear();
         for (unsigned int i = 0; i < fObservableNames.size(); i++) {
             fObservableIdMap[(string)fObservableNames[i]] = i;
         }
@@ -485,7 +500,7 @@ void TRestAnalysisTree::ReadLeafValueToObservable(TLeaf* lf, RESTValue& obs) {
                     type = "char";
                     break;
                 case 'S':
-                    type = "stort";
+                    type = "short";
                     break;
                 case 'I':
                     type = "int";
@@ -530,24 +545,32 @@ void TRestAnalysisTree::ReadLeafValueToObservable(TLeaf* lf, RESTValue& obs) {
     if (obs.is_data_type) {
         // the observable is basic type, we directly set it address from leaf
         obs.address = (char*)lf->GetValuePointer();
-    } else if (obs.type == "vector<double>") {
-        auto ptr = (double*)lf->GetValuePointer();
-        vector<double> val(ptr, ptr + lf->GetLen());
-        obs.SetValue(val);
-    } else if (obs.type == "vector<int>") {
-        int* ptr = (int*)lf->GetValuePointer();
-        vector<int> val(ptr, ptr + lf->GetLen());
-        obs.SetValue(val);
-    } else if (obs.type == "vector<float>") {
-        auto ptr = (float*)lf->GetValuePointer();
-        vector<float> val(ptr, ptr + lf->GetLen());
-        obs.SetValue(val);
-    } else if (obs.type == "string") {
-        char* ptr = (char*)lf->GetValuePointer();
-        string val(ptr, lf->GetLen());
-        obs.SetValue(val);
-    } else {
-        RESTWarning << "Unsupported observable type to convert from TLeaf!" << RESTendl;
+        return;
+    }
+
+    switch (obs.tag) {
+        case REST_Reflection::kVectorDoubleType: {
+            auto ptr = (double*)lf->GetValuePointer();
+            ((vector<double>*)obs.address)->assign(ptr, ptr + lf->GetLen());
+            break;
+        }
+        case REST_Reflection::kVectorIntType: {
+            auto ptr = (int*)lf->GetValuePointer();
+            ((vector<int>*)obs.address)->assign(ptr, ptr + lf->GetLen());
+            break;
+        }
+        case REST_Reflection::kVectorFloatType: {
+            auto ptr = (float*)lf->GetValuePointer();
+            ((vector<float>*)obs.address)->assign(ptr, ptr + lf->GetLen());
+            break;
+        }
+        case REST_Reflection::kStringType: {
+            auto ptr = (char*)lf->GetValuePointer();
+            ((string*)obs.address)->assign(ptr, lf->GetLen());
+            break;
+        }
+        default:
+            RESTWarning << "Unsupported observable type to convert from TLeaf!" << RESTendl;
     }
 }
 
@@ -615,16 +638,17 @@ Double_t TRestAnalysisTree::GetDblObservableValue(const string& obsName) {
 ///////////////////////////////////////////////
 /// \brief Get double value of the observable, according to the id.
 ///
-/// It assumes the observable is in double/int type. If not it will print error and return 0
+/// It assumes the observable is in a basic numeric type. If not it will print error and return 0
 Double_t TRestAnalysisTree::GetDblObservableValue(Int_t n) {
-    if (n >= fNObservables) {
+    if (n < 0 || n >= fNObservables) {
         cout << "Error! TRestAnalysisTree::GetDblObservableValue(): index outside limits!" << endl;
         return 0;
     }
 
-    if (GetObservableType(n) == "int") return GetObservableValue<int>(n);
-    if (GetObservableType(n) == "float") return GetObservableValue<float>(n);
-    if (GetObservableType(n) == "double") return GetObservableValue<double>(n);
+    RESTValue obs = GetObservable(n);
+    if (REST_Reflection::GetTypeOperations(obs.tag).ToDouble != nullptr) {
+        return obs.ToDouble();
+    }
 
     cout << "TRestAnalysisTree::GetDblObservableValue. Type " << GetObservableType(n)
          << " not supported! Returning zero" << endl;
@@ -656,6 +680,7 @@ RESTValue TRestAnalysisTree::AddObservable(const TString& observableName, const
         if (!ptr.IsZombie()) {
             fObservableNames.push_back(observableName);
             fObservableIdMap[(string)observableName] = fObservableNames.size() - 1;
+            fObservableIdSearchMap.clear();  // a missing name may match the new observable
             fObservableDescriptions.push_back(description);
             fObservableTypes.push_back(observableType);
             fObservables.push_back(ptr);
@@ -713,7 +738,11 @@ void TRestAnalysisTree::PrintObservable(int n) {
               << "    Value : " << ToString(obsVal, lengthRemaining) << std::endl;
 }
 
-Int_t TRestAnalysisTree::GetEntry(Long64_t entry, Int_t getall) {
+///////////////////////////////////////////////
+/// \brief Make the observables ready to be read from the branches, following the
+/// "GetEntry Logic" of the status table.
+///
+void TRestAnalysisTree::PrepareForReading() {
     if (fStatus == None) fStatus = EvaluateStatus();
 
     if (fStatus == Created) {
@@ -725,6 +754,10 @@ Int_t TRestAnalysisTree::GetEntry(Long64_t entry, Int_t getall) {
     } else if (fStatus == Connected) {
     } else if (fStatus == Filled) {
     }
+}
+
+Int_t TRestAnalysisTree::GetEntry(Long64_t entry, Int_t getall) {
+    PrepareForReading();
 
     if (fChain != nullptr) {
         return fChain->GetEntry(entry, getall);
@@ -765,6 +798,21 @@ void TRestAnalysisTree::SetEventInfo(TRestEvent* evt) {
     }
 }
 
+void TRestAnalysisTree::SetEventInfo(Int_t runOrigin, Int_t subRunOrigin, Int_t eventID, Int_t subEventID,
+                                     Double_t timeStamp, const TString& subEventTag) {
+    if (fChain != nullptr) {
+        cout << "Error! cannot fill tree. AnalysisTree is in chain state" << endl;
+        return;
+    }
+
+    fEventID = eventID;
+    fSubEventID = subEventID;
+    fTimeStamp = timeStamp;
+    *fSubEventTag = subEventTag;
+    fRunOrigin = runOrigin;
+    fSubRunOrigin = subRunOrigin;
+}
+
 Int_t TRestAnalysisTree::Fill() {
     if (fStatus == None) fStatus = EvaluateStatus();
 
@@ -823,7 +871,7 @@ void TRestAnalysisTree::SetObservable(Int_t id, RESTValue obs) {
         id = GetObservableID(obs.name);
     }
     if (id != -1) {
-        if (obs.type != fObservables[id].type) {
+        if (!obs.IsSameType(fObservables[id])) {
             // if the observable branches are not created, and the type doesn't match,
             // we still have the chance to fix. We reset fObservableTypes and fObservableMemory
             // according to the input type value.
@@ -964,6 +1012,34 @@ void TRestAnalysisTree::DisableBranches(vector<string> obsNames) {
     for (auto& obsName : obsNames) this->SetBranchStatus(obsName.c_str(), false);
 }
 
+///////////////////////////////////////////////
+/// \brief It will disable all the branches but the ones given by argument.
+///
+/// It returns the previous status of the branches in the tree, to be given to
+/// RestoreBranchStatus() once the loop reading the enabled branches is done.
+///
+std::vector<Bool_t> TRestAnalysisTree::EnableOnlyBranches(const vector<string>& obsNames) {
+    std::vector<Bool_t> status;
+    auto branches = GetListOfBranches();
+    for (int i = 0; i < branches->GetEntriesFast(); i++) {
+        status.push_back(GetBranchStatus(branches->UncheckedAt(i)->GetName()));
+    }
+
+    DisableAllBranches();
+    for (auto& obsName : obsNames) this->SetBranchStatus(obsName.c_str(), true);
+    return status;
+}
+
+///////////////////////////////////////////////
+/// \brief It will set back the branch status returned by EnableOnlyBranches()
+///
+void TRestAnalysisTree::RestoreBranchStatus(const std::vector<Bool_t>& status) {
+    auto branches = GetListOfBranches();
+    for (int i = 0; i < branches->GetEntriesFast() && i < (int)status.size(); i++) {
+        this->SetBranchStatus(branches->UncheckedAt(i)->GetName(), status[i]);
+    }
+}
+
 ///////////////////////////////////////////////
 /// \brief It will enable all branches in the tree
 ///
@@ -987,6 +1063,22 @@ void TRestAnalysisTree::EnableQuickObservableValueSetting() { this->fQuickSetObs
 /// \brief It will disable quick observable value setting
 void TRestAnalysisTree::DisableQuickObservableValueSetting() { this->fQuickSetObservableValue = false; }
 
+///////////////////////////////////////////////
+/// \brief It returns the branch of the observable with the given id, ready to read
+/// the observable value with TBranch::GetEntry().
+///
+/// The statistics getters read only this branch for each entry, instead of calling
+/// TTree::GetEntry(), which would read and decompress all the observables in the tree.
+///
+TBranch* TRestAnalysisTree::GetObservableBranch(Int_t id) {
+    PrepareForReading();
+    TBranch* branch = TTree::GetBranch(fObservableNames[id]);
+    if (branch == nullptr) {
+        RESTError << "TRestAnalysisTree: no branch for observable: " << fObservableNames[id] << RESTendl;
+    }
+    return branch;
+}
+
 ///////////////////////////////////////////////
 /// \brief It returns the integral of the observable considering the given range. If no range is given
 /// the full histogram range will be considered.
@@ -1000,9 +1092,12 @@ Double_t TRestAnalysisTree::GetObservableIntegral(const TString& obsName, Double
         return 0;
     }
 
+    TBranch* branch = GetObservableBranch(id);
+    if (branch == nullptr) return 0;
+
     Double_t sum = 0;
-    for (Int_t n = 0; n < TTree::GetEntries(); n++) {
-        TTree::GetEntry(n);
+    for (Long64_t n = 0; n < TTree::GetEntries(); n++) {
+        branch->GetEntry(n);
         Double_t value = GetDblObservableValue(id);
 
         if (xLow != -1 && xHigh != -1 && (value < xLow || value > xHigh)) continue;
@@ -1025,10 +1120,13 @@ Double_t TRestAnalysisTree::GetObservableAverage(const TString& obsName, Double_
         return 0;
     }
 
+    TBranch* branch = GetObservableBranch(id);
+    if (branch == nullptr) return 0;
+
     Double_t sum = 0;
     Int_t N = 0;
-    for (Int_t n = 0; n < TTree::GetEntries(); n++) {
-        TTree::GetEntry(n);
+    for (Long64_t n = 0; n < TTree::GetEntries(); n++) {
+        branch->GetEntry(n);
         Double_t value = GetDblObservableValue(id);
 
         if (xLow != -1 && xHigh != -1 && (value < xLow || value > xHigh)) continue;
@@ -1049,11 +1147,15 @@ Double_t TRestAnalysisTree::GetObservableRMS(const TString& obsName, Double_t xL
     Double_t mean = GetObservableAverage(obsName, xLow, xHigh);
 
     Int_t id = GetObservableID((std::string)obsName);
+    if (id < 0) return 0;
+
+    TBranch* branch = GetObservableBranch(id);
+    if (branch == nullptr) return 0;
 
     Double_t sum = 0;
     Int_t N = 0;
-    for (Int_t n = 0; n < TTree::GetEntries(); n++) {
-        TTree::GetEntry(n);
+    for (Long64_t n = 0; n < TTree::GetEntries(); n++) {
+        branch->GetEntry(n);
         Double_t value = GetDblObservableValue(id);
 
         if (xLow != -1 && xHigh != -1 && (value < xLow || value > xHigh)) continue;
@@ -1080,9 +1182,12 @@ Double_t TRestAnalysisTree::GetObservableMaximum(const TString& obsName, Double_
         return 0;
     }
 
+    TBranch* branch = GetObservableBranch(id);
+    if (branch == nullptr) return 0;
+
     Double_t max = -DBL_MAX;
-    for (Int_t n = 0; n < TTree::GetEntries(); n++) {
-        TTree::GetEntry(n);
+    for (Long64_t n = 0; n < TTree::GetEntries(); n++) {
+        branch->GetEntry(n);
         Double_t value = GetDblObservableValue(id);
 
         if (xLow != -1 && xHigh != -1 && (value < xLow || value > xHigh)) continue;
@@ -1105,9 +1210,12 @@ Double_t TRestAnalysisTree::GetObservableMinimum(const TString& obsName, Double_
         return 0;
     }
 
+    TBranch* branch = GetObservableBranch(id);
+    if (branch == nullptr) return 0;
+
     Double_t min = DBL_MAX;
-    for (Int_t n = 0; n < TTree::GetEntries(); n++) {
-        TTree::GetEntry(n);
+    for (Long64_t n = 0; n < TTree::GetEntries(); n++) {
+        branch->GetEntry(n);
         Double_t value = GetDblObservableValue(id);
 
         if (xLow != -1 && xHigh != -1 && (value < xLow || value > xHigh)) continue;
@@ -1217,8 +1325,8 @@ Int_t TRestAnalysisTree::WriteAsTTree(const char* name, Int_t option, Int_t bufs
 /// <param name="file"> The input file that contains another AnalysisTree with same run id </param>
 /// <returns></returns>
 Bool_t TRestAnalysisTree::AddChainFile(const string& _file) {
-    auto file = std::unique_ptr<TFile>{TFile::Open(_file.c_str(), "update")};
-    if (!file->IsOpen()) {
+    auto file = std::unique_ptr<TFile>{TFile::Open(_file.c_str())};
+    if (file == nullptr || !file->IsOpen()) {
         RESTWarning << "TRestAnalysisTree::AddChainFile(): failed to open file " << _file << RESTendl;
         return false;
     }
@@ -1234,11 +1342,7 @@ Bool_t TRestAnalysisTree::AddChainFile(const string& _file) {
                 // this is a valid tree
                 delete tree;
 
-                if (fChain == nullptr) {
-                    fChain = new TChain("AnalysisTree", "Chained AnalysisTree");
-                    fChain->Add(this->GetCurrentFile()->GetName());
-                }
-                return fChain->Add(_file.c_str()) == 1;
+                return AppendChainFile(_file);
             }
             RESTWarning
                 << "TRestAnalysisTree::AddChainFile(): invalid file, AnalysisTree in file has different "
@@ -1255,6 +1359,22 @@ Bool_t TRestAnalysisTree::AddChainFile(const string& _file) {
     return false;
 }
 
+/// <summary>
+/// Add the AnalysisTree of a file to the chain, without checking it.
+/// </summary>
+/// <param name="file"> The file, whose AnalysisTree must have the same observables as this one. It can
+/// belong to a different run, see TRestRun::ChainInputFiles() </param>
+/// <param name="entries"> The entries of the tree in the file if known, so that it is not opened
+/// again </param>
+/// <returns></returns>
+Bool_t TRestAnalysisTree::AppendChainFile(const string& file, Long64_t entries) {
+    if (fChain == nullptr) {
+        fChain = new TChain("AnalysisTree", "Chained AnalysisTree");
+        fChain->Add(this->GetCurrentFile()->GetName());
+    }
+    return fChain->Add(file.c_str(), entries) == 1;
+}
+
 /// <summary>
 /// Overrides TTree::GetTree(), to get the actual tree used in case of chain operation(fCurrentTree !=
 /// nullptr)
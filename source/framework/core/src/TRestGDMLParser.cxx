@@ -1,9 +1,26 @@
 #include "TRestGDMLParser.h"
 
 #include <filesystem>
+#include <iomanip>
+#include <sstream>
 
 using namespace std;
 
+namespace {
+// the version of the preprocessing done by TRestGDMLParser::Load(), to be increased when its output changes
+constexpr int kPreprocessingVersion = 1;
+
+// the FNV-1a hash of REST_StringHelper::ToHash(), computed without copying the string
+constexpr ULong64_t kFNVOffsetBasis = 0xCBF29CE484222325ull;
+ULong64_t HashAppend(ULong64_t hash, const string& str) {
+    for (const char c : str) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+}  // namespace
+
 string TRestGDMLParser::GetEntityVersion(const string& name) const {
     for (auto& [entityName, entityVersion] : fEntityVersionMap) {
         if (entityName == name) {
@@ -49,36 +66,58 @@ void TRestGDMLParser::Load(const string& filename) {
         LoadSectionMetadata();
     }
 
-    cout << "TRestGDMLParser: Replacing expressions in GDML" << endl;
     ReplaceEntity();
-    fFileString = Replace(fFileString, "= \"", "=\"");
-    fFileString = Replace(fFileString, " =\"", "=\"");
-    fFileString = Replace(fFileString, " = \"", "=\"");
 
-    ReplaceAttributeWithKeyWord("cos(");
-    ReplaceAttributeWithKeyWord("sin(");
-    ReplaceAttributeWithKeyWord("tan(");
-    ReplaceAttributeWithKeyWord("sqrt(");
-    ReplaceAttributeWithKeyWord("log(");
-    ReplaceAttributeWithKeyWord("exp(");
+    // After the entities are expanded, the rest of the preprocessing only depends on the file content, on
+    // the constants of the define section and on the framework build evaluating the expressions. Its result
+    // is kept in a file named after a hash of them, so that the jobs loading the same geometry reuse it
+    // instead of evaluating the expressions again
+    ULong64_t cacheKey = HashAppend(kFNVOffsetBasis, (string)REST_RELEASE + "/" + REST_COMMIT + "/" +
+                                                         to_string(kPreprocessingVersion) + "\n");
+    cacheKey = HashAppend(cacheKey, fFileString);
+    for (const auto& [name, value] : fConstants) {
+        cacheKey = HashAppend(HashAppend(cacheKey, "\n" + name + "="), value);
+    }
+    stringstream hash;
+    hash << hex << setw(16) << setfill('0') << cacheKey;
 
     string filenameNoPath = TRestTools::SeparatePathAndName(filenameAbsolute).second;
-    // we have to use a unique identifier on the file to prevent collision when launching multiple jobs
-    fOutputGdmlFilename = fOutputGdmlDirectory + "PID" + std::to_string(getpid()) + "_" + filenameNoPath;
-    cout << "TRestGDMLParser: Creating temporary file at: \"" << fOutputGdmlFilename << "\"" << endl;
+    fOutputGdmlFilename = fOutputGdmlDirectory + hash.str() + "_" + filenameNoPath;
+
+    std::error_code error;
+    const auto cachedSize = filesystem::file_size(fOutputGdmlFilename, error);
+    if (!error && cachedSize > 0) {
+        cout << "TRestGDMLParser: Using preprocessed file at: \"" << fOutputGdmlFilename << "\"" << endl;
+        std::ifstream cachedFile(fOutputGdmlFilename);
+        fFileString.assign(std::istreambuf_iterator<char>(cachedFile), std::istreambuf_iterator<char>());
+        return;
+    }
+
+    cout << "TRestGDMLParser: Replacing expressions in GDML" << endl;
+    ReplaceAttributeExpressions();
+
+    // we have to use a unique identifier on the file to prevent collision when launching multiple jobs. It is
+    // renamed to its final name once complete, so that the other jobs never read a partial file
+    string temporaryFilename = fOutputGdmlDirectory + "PID" + std::to_string(getpid()) + "_" + filenameNoPath;
+    cout << "TRestGDMLParser: Creating temporary file at: \"" << temporaryFilename << "\"" << endl;
 
     filesystem::create_directories(fOutputGdmlDirectory);
 
     ofstream outputFile;
-    outputFile.open(fOutputGdmlFilename, ios::trunc);
+    outputFile.open(temporaryFilename, ios::trunc);
     outputFile << fFileString << endl;
     outputFile.close();
 
-    std::ifstream fileToCheckExistence(fOutputGdmlFilename);
+    std::ifstream fileToCheckExistence(temporaryFilename);
     if (!fileToCheckExistence) {
         std::cout << "TRestGDMLParser: Problem writing temporary file." << std::endl;
         exit(1);
     }
+
+    filesystem::rename(temporaryFilename, fOutputGdmlFilename, error);
+    if (error) {
+        fOutputGdmlFilename = temporaryFilename;
+    }
 }
 
 TGeoManager* TRestGDMLParser::CreateGeoManager() {
@@ -154,31 +193,57 @@ void TRestGDMLParser::ReplaceEntity() {
     }
 }
 
-void TRestGDMLParser::ReplaceAttributeWithKeyWord(const string& keyword) {
-    int n;
-    while ((n = fFileString.find(keyword, 0)) != -1) {
-        int pos1 = 0, pos2 = 0;
-        for (int i = n; i >= 0; i--) {
-            if (fFileString[i] == '"') {
-                pos1 = i + 1;
-                break;
-            }
-        }
+void TRestGDMLParser::ReplaceAttributeExpressions() {
+    static const vector<string> keywords = {"cos(", "sin(", "tan(", "sqrt(", "log(", "exp("};
+
+    const string& input = fFileString;
+    auto at = [&input](size_t i) { return i < input.size() ? input[i] : '\0'; };
+
+    string output;
+    output.reserve(input.size());
 
-        for (unsigned int i = n; i < fFileString.size(); i++) {
-            if (fFileString[i] == '"') {
-                pos2 = i;
+    // the text between two quotes is evaluated when it contains a mathematical function
+    size_t segmentStart = 0;
+    auto closeSegment = [&]() {
+        bool found = false;
+        for (const auto& keyword : keywords) {
+            if (output.find(keyword, segmentStart) != string::npos) {
+                found = true;
                 break;
             }
         }
-        string target = fFileString.substr(pos1, pos2 - pos1);
-        string replace = ReplaceMathematicalExpressions(ReplaceConstants(ReplaceVariables(target)));
+        if (!found) return;
 
+        string target = output.substr(segmentStart);
+        string replace = ReplaceMathematicalExpressions(ReplaceConstants(ReplaceVariables(target)));
         if (replace == target) {
             cout << "Error! failed to replace mathematical expressions! check the file!" << endl;
             cout << replace << endl;
             exit(1);
         }
-        fFileString.replace(pos1, pos2 - pos1, replace);
+        output.resize(segmentStart);
+        output += replace;
+    };
+
+    for (size_t i = 0; i < input.size(); i++) {
+        const char c = input[i];
+        if (c == '=' && at(i + 1) == ' ' && at(i + 2) == '"') {
+            // "= \"" -> "=\"", the quote is handled in the next iteration
+            output += c;
+            i++;
+        } else if (c == ' ' && at(i + 1) == '=' &&
+                   (at(i + 2) == '"' || (at(i + 2) == ' ' && at(i + 3) == '"'))) {
+            // " =\"" -> "=\"", one space only as the former Replace() calls did
+            continue;
+        } else if (c == '"') {
+            closeSegment();
+            output += c;
+            segmentStart = output.size();
+        } else {
+            output += c;
+        }
     }
+    closeSegment();
+
+    fFileString.swap(output);
 }
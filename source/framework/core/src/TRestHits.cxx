@@ -44,6 +44,8 @@
 /// where two hits are added, one to each side of the event, and a Gaussian is fitted.
 /// The hits are added so that the fit works even for small events as shown in the figure below.
 /// The parameter sigma is extracted from the fit and its absolute value is returned.
+/// Passing `fast = true`, the same least squares problem is solved directly on the hit
+/// data, without creating the graph and the TF1 of the fit.
 ///
 /// \htmlonly <style>div.image img[src="hitsGaussianFit.png"]{width:500px;}</style> \endhtmlonly
 /// ![An illustration of the GetGaussSigmaX method and why two hits are added.](hitsGaussianFit.png)
@@ -68,6 +70,12 @@
 /// 2022-July: Introducing gausian hits fitting
 /// \author    Cristina Margalejo (cmargalejo@unizar.es)
 ///
+/// 2026-October: Sorting through an index permutation, applied once to every hit
+///               data member (GetSortingPermutation, ApplyPermutation, Sort).
+///               Bulk removal and merging of hits in a single pass (RemoveHitsByMask,
+///               RemoveHitsIf, MergeHitPairs, MergeHitClusters).
+///               Gaussian sigma estimation without ROOT objects (EstimateGaussSigma).
+///
 /// \class TRestHits
 ///
 /// <hr>
@@ -77,8 +85,13 @@
 
 #include <limits.h>
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
 #include "TFitResult.h"
 #include "TROOT.h"
+#include "TRestStringOutput.h"
 
 using namespace std;
 using namespace TMath;
@@ -456,19 +469,25 @@ Double_t TRestHits::GetMeanHitEnergy() const { return GetTotalEnergy() / GetNumb
 /// and being its final energy the addition of the energies of the hits `n` and `m`.
 ///
 void TRestHits::MergeHits(int n, int m) {
-    Double_t totalEnergy = fEnergy[n] + fEnergy[m];
-    fX[n] = (fX[n] * fEnergy[n] + fX[m] * fEnergy[m]) / totalEnergy;
-    fY[n] = (fY[n] * fEnergy[n] + fY[m] * fEnergy[m]) / totalEnergy;
-    fZ[n] = (fZ[n] * fEnergy[n] + fZ[m] * fEnergy[m]) / totalEnergy;
-    fTime[n] = (fTime[n] * fEnergy[n] + fTime[m] * fEnergy[m]) / totalEnergy;
-    fEnergy[n] += fEnergy[m];
+    MergeHitInto(n, m);
+    RemoveHit(m);
+}
 
-    fX.erase(fX.begin() + m);
-    fY.erase(fY.begin() + m);
-    fZ.erase(fZ.begin() + m);
-    fTime.erase(fTime.begin() + m);
-    fEnergy.erase(fEnergy.begin() + m);
-    fType.erase(fType.begin() + m);
+///////////////////////////////////////////////
+/// \brief It moves hit `source` into hit `target`, which is placed at the energy weighted
+/// center and time of both hits and gets the addition of their energies. Hit `source` is
+/// left in the list, unchanged.
+///
+/// Derived classes storing additional hit data must override it to merge that data
+/// before calling this method, which modifies the hit energy.
+///
+void TRestHits::MergeHitInto(size_t target, size_t source) {
+    Double_t totalEnergy = fEnergy[target] + fEnergy[source];
+    fX[target] = (fX[target] * fEnergy[target] + fX[source] * fEnergy[source]) / totalEnergy;
+    fY[target] = (fY[target] * fEnergy[target] + fY[source] * fEnergy[source]) / totalEnergy;
+    fZ[target] = (fZ[target] * fEnergy[target] + fZ[source] * fEnergy[source]) / totalEnergy;
+    fTime[target] = (fTime[target] * fEnergy[target] + fTime[source] * fEnergy[source]) / totalEnergy;
+    fEnergy[target] += fEnergy[source];
 }
 
 ///////////////////////////////////////////////
@@ -485,11 +504,11 @@ void TRestHits::SwapHits(Int_t i, Int_t j) {
 }
 
 ///////////////////////////////////////////////
-/// \brief It returns true if the hits are ordered in increasing energies.
+/// \brief It returns true if the hits are ordered in decreasing energies.
 ///
 Bool_t TRestHits::isSortedByEnergy() const {
-    for (unsigned int i = 0; i < GetNumberOfHits() - 1; i++) {
-        if (GetEnergy(i + 1) > GetEnergy(i)) {
+    for (size_t i = 1; i < GetNumberOfHits(); i++) {
+        if (GetEnergy(i) > GetEnergy(i - 1)) {
             return false;
         }
     }
@@ -497,6 +516,92 @@ Bool_t TRestHits::isSortedByEnergy() const {
     return true;
 }
 
+///////////////////////////////////////////////
+/// \brief It returns the hit indices ordered by the quantity `key`, without modifying
+/// the hits.
+///
+/// The hits are ordered in increasing values, or in decreasing values if `descending` is
+/// true. Hits with a NaN value, i.e. the missing coordinate of XY, XZ or YZ hits, are
+/// placed at the end. When `stable` is true the hits having the same value keep their
+/// current relative order.
+///
+/// The returned permutation can be passed to ApplyPermutation.
+///
+std::vector<size_t> TRestHits::GetSortingPermutation(SortKey key, Bool_t descending, Bool_t stable) const {
+    const std::vector<Float_t>* values = &fEnergy;
+    if (key == kSortByX) {
+        values = &fX;
+    } else if (key == kSortByY) {
+        values = &fY;
+    } else if (key == kSortByZ) {
+        values = &fZ;
+    } else if (key == kSortByTime) {
+        values = &fTime;
+    }
+
+    std::vector<size_t> order(GetNumberOfHits());
+    std::iota(order.begin(), order.end(), 0);
+
+    const std::vector<Float_t>& v = *values;
+    auto compare = [&v, descending](size_t i, size_t j) {
+        if (IsNaN(v[i])) return false;
+        if (IsNaN(v[j])) return true;
+        return descending ? v[i] > v[j] : v[i] < v[j];
+    };
+
+    if (stable) {
+        std::stable_sort(order.begin(), order.end(), compare);
+    } else {
+        std::sort(order.begin(), order.end(), compare);
+    }
+
+    return order;
+}
+
+///////////////////////////////////////////////
+/// \brief It reorders the hits so that hit `i` becomes the former hit `order[i]`.
+///
+/// `order` must be a permutation of the hit indices, as the one returned by
+/// GetSortingPermutation. Each data member is reordered in a single pass, so derived
+/// classes storing additional hit data must reorder it as well.
+///
+void TRestHits::ApplyPermutation(const std::vector<size_t>& order) {
+    if (order.size() != GetNumberOfHits()) {
+        RESTError << "TRestHits::ApplyPermutation. The permutation size (" << order.size()
+                  << ") does not match the number of hits (" << GetNumberOfHits() << ")" << RESTendl;
+        return;
+    }
+
+    PermuteColumn(fX, order);
+    PermuteColumn(fY, order);
+    PermuteColumn(fZ, order);
+    PermuteColumn(fTime, order);
+    PermuteColumn(fEnergy, order);
+    PermuteColumn(fType, order);
+}
+
+///////////////////////////////////////////////
+/// \brief It sorts the hits by the quantity `key`. See GetSortingPermutation for the
+/// meaning of the arguments.
+///
+void TRestHits::Sort(SortKey key, Bool_t descending, Bool_t stable) {
+    ApplyPermutation(GetSortingPermutation(key, descending, stable));
+}
+
+///////////////////////////////////////////////
+/// \brief It sorts the hits in decreasing energies. If `stable` is true, the hits with
+/// the same energy keep their current relative order.
+///
+/// Note that this is not the order of equal-energy hits given by the exchange sort of
+/// TRestVolumeHits::SortByEnergy before 2026-October, which was not stable: for the
+/// energies {2a, 2b, 3} it gave {3, 2b, 2a}, while `stable` gives {3, 2a, 2b}. Without
+/// `stable`, the order of equal-energy hits is unspecified.
+///
+void TRestHits::SortByEnergy(Bool_t stable) {
+    if (isSortedByEnergy()) return;
+    Sort(kSortByEnergy, true, stable);
+}
+
 ///////////////////////////////////////////////
 /// \brief It removes the hit at position `n` from the list.
 ///
@@ -509,6 +614,112 @@ void TRestHits::RemoveHit(int n) {
     fType.erase(fType.begin() + n);
 }
 
+///////////////////////////////////////////////
+/// \brief It removes all the hits `n` having `remove[n]` true, in a single pass over the
+/// hit data.
+///
+/// The remaining hits keep their relative order. Removing many hits this way is linear
+/// in the number of hits, while repeated calls to RemoveHit are quadratic.
+///
+void TRestHits::RemoveHitsByMask(const std::vector<Bool_t>& remove) {
+    if (remove.size() != GetNumberOfHits()) {
+        RESTError << "TRestHits::RemoveHitsByMask. The mask size (" << remove.size()
+                  << ") does not match the number of hits (" << GetNumberOfHits() << ")" << RESTendl;
+        return;
+    }
+
+    RemoveFromColumn(fX, remove);
+    RemoveFromColumn(fY, remove);
+    RemoveFromColumn(fZ, remove);
+    RemoveFromColumn(fTime, remove);
+    RemoveFromColumn(fEnergy, remove);
+    RemoveFromColumn(fType, remove);
+}
+
+///////////////////////////////////////////////
+/// \brief It removes all the hits whose index satisfies `predicate`. See RemoveHitsByMask.
+///
+/// \code
+/// hits.RemoveHitsIf([&hits](size_t n) { return hits.GetEnergy(n) < 0.1; });
+/// \endcode
+///
+void TRestHits::RemoveHitsIf(const std::function<Bool_t(size_t)>& predicate) {
+    std::vector<Bool_t> remove(GetNumberOfHits());
+    for (size_t n = 0; n < remove.size(); n++) remove[n] = predicate(n);
+
+    RemoveHitsByMask(remove);
+}
+
+///////////////////////////////////////////////
+/// \brief It merges each pair of hits (target, source) as MergeHits(target, source)
+/// would do, but removing all the merged hits in a single pass at the end.
+///
+/// The indices refer to the hits before any merge, and the pairs may be chained, e.g.
+/// {(0, 1), (1, 2)} merges the hits 0, 1 and 2. Each resulting hit takes the place of
+/// the lowest index of its group. See MergeHitClusters.
+///
+void TRestHits::MergeHitPairs(const std::vector<std::pair<size_t, size_t>>& pairs) {
+    const size_t nHits = GetNumberOfHits();
+
+    std::vector<size_t> group(nHits);
+    std::iota(group.begin(), group.end(), 0);
+    auto root = [&group](size_t n) {
+        while (group[n] != n) {
+            group[n] = group[group[n]];
+            n = group[n];
+        }
+        return n;
+    };
+
+    for (const auto& [target, source] : pairs) {
+        if (target >= nHits || source >= nHits) {
+            RESTError << "TRestHits::MergeHitPairs. Hit pair (" << target << ", " << source
+                      << ") out of range. Number of hits: " << nHits << RESTendl;
+            return;
+        }
+        size_t a = root(target), b = root(source);
+        if (a != b) group[max(a, b)] = min(a, b);
+    }
+
+    std::vector<Int_t> labels(nHits);
+    for (size_t n = 0; n < nHits; n++) labels[n] = root(n);
+
+    MergeHitClusters(labels);
+}
+
+///////////////////////////////////////////////
+/// \brief It merges all the hits having the same label into a single hit, placed at the
+/// position of the first hit of the cluster. Hits with a negative label are removed.
+///
+/// `labels` must contain one label per hit, e.g. the output of a clustering algorithm.
+/// The merge of each cluster is the same as merging its hits one by one with MergeHits,
+/// but the hit data is compacted in a single pass at the end.
+///
+void TRestHits::MergeHitClusters(const std::vector<Int_t>& labels) {
+    if (labels.size() != GetNumberOfHits()) {
+        RESTError << "TRestHits::MergeHitClusters. The number of labels (" << labels.size()
+                  << ") does not match the number of hits (" << GetNumberOfHits() << ")" << RESTendl;
+        return;
+    }
+
+    std::vector<Bool_t> remove(labels.size(), false);
+    std::unordered_map<Int_t, size_t> clusterHit;
+    for (size_t n = 0; n < labels.size(); n++) {
+        if (labels[n] < 0) {
+            remove[n] = true;
+            continue;
+        }
+
+        auto [it, isFirst] = clusterHit.emplace(labels[n], n);
+        if (!isFirst) {
+            MergeHitInto(it->second, n);
+            remove[n] = true;
+        }
+    }
+
+    RemoveHitsByMask(remove);
+}
+
 ///////////////////////////////////////////////
 /// \brief It returns the position of hit number `n`.
 ///
@@ -753,223 +964,222 @@ void TRestHits::GetBoundaries(std::vector<double>& dist, double& max, double& mi
     min -= offset * minDiff + minDiff / 2.;
     nBins = std::round((max - min) / minDiff);
 }
+
 ///////////////////////////////////////////////
-/// \brief It computes the gaussian sigma in the X-coordinate.
-/// It adds a hit to the right and a hit to the left, with energy = 0 +/- user defined error in ADC.
-/// Then it fits a gaussian to the hits and extracts the sigma. The hits are just added
-/// for fitting purposes and do not go into any further processing.
+/// \brief It fits a gaussian to the energy distribution along `position`, which is one of
+/// the hit coordinate vectors, and returns its sigma. See GetGaussSigmaX.
 ///
-Double_t TRestHits::GetGaussSigmaX(Double_t error, Int_t nHitsMin) {
-    Double_t gausSigmaX = 0;
+/// It returns -1 if the fit fails.
+///
+Double_t TRestHits::FitGaussSigma(const std::vector<Float_t>& position, Double_t error,
+                                  Int_t nHitsMin) const {
     Int_t nHits = GetNumberOfHits();
     if (nHits <= 0) {
-        gausSigmaX = 0;
-    } else {
-        Int_t nAdd = 0;
-        // bool doHitCorrection = true;
-        // bool doHitCorrection = nHits <= 18; //in case we want to apply it only to the smaller events
-        bool doHitCorrection = nHits <= nHitsMin;
-        if (doHitCorrection) {
-            nAdd = 2;
-        }
-        Int_t nElems = nHits + nAdd;
-        vector<Double_t> x(nElems), y(nElems), ex(nElems), ey(nElems);
-        Int_t k = nAdd / 2;
-        Double_t xMin = std::numeric_limits<double>::max();
-        Double_t xMax = std::numeric_limits<double>::lowest();
-        for (unsigned int n = 0; n < GetNumberOfHits(); k++, n++) {
-            x[k] = fX[n];
-            y[k] = fEnergy[n];
-            ex[k] = 0;
-            xMin = min(xMin, x[k]);
-            xMax = max(xMax, x[k]);
-            if (y[k] != 0) {
-                ey[k] = 10 * sqrt(y[k]);
-            } else {
-                ey[k] = 0;
-            }
-        }
-        Int_t h = nHits + nAdd / 2;
-        if (doHitCorrection) {
-            x[0] = xMin - 0.5;
-            x[h] = xMax + 0.5;
-            y[0] = 0.0;
-            y[h] = 0.0;
-            ex[0] = 0.0;
-            ex[h] = 0.0;
-            ey[0] = error;
-            ey[h] = error;
-        }
-        TGraphErrors* grX = new TGraphErrors(nElems, &x[0], &y[0], &ex[0], &ey[0]);
-        // TCanvas *c = new TCanvas("c","X position fit",200,10,500,500);
-        // grX->Draw();
-        // Defining the starting parameters for the fit.
-        Double_t maxY = MaxElement(nElems, grX->GetY());
-        Double_t maxX = grX->GetX()[LocMax(nElems, grX->GetY())];
-        Double_t sigma = abs(x[0] - x[h]) / 2.0;
-        // std::cout << "maxX: " << maxX << ", maxY: " << maxY << ", sigma: " << sigma << std::endl;
-
-        TF1* fit = new TF1("", "gaus");
-        fit->SetParameter(0, maxY);
-        fit->SetParameter(1, maxX);
-        fit->SetParameter(2, sigma);
-        TFitResultPtr fitResult =
-            grX->Fit(fit, "QNBS");  // Q = quiet, no info in screen; N = no plot; B = no automatic start
-                                    // parameters; R = Use the Range specified in the function range; S = save
-                                    // and return the fit result.
-        if (fitResult->IsValid()) {
-            gausSigmaX = fit->GetParameter(2);
+        return 0;
+    }
+
+    Int_t nAdd = 0;
+    // bool doHitCorrection = true;
+    // bool doHitCorrection = nHits <= 18; //in case we want to apply it only to the smaller events
+    bool doHitCorrection = nHits <= nHitsMin;
+    if (doHitCorrection) {
+        nAdd = 2;
+    }
+    Int_t nElems = nHits + nAdd;
+    vector<Double_t> x(nElems), y(nElems), ex(nElems), ey(nElems);
+    Int_t k = nAdd / 2;
+    Double_t xMin = std::numeric_limits<double>::max();
+    Double_t xMax = std::numeric_limits<double>::lowest();
+    for (int n = 0; n < nHits; k++, n++) {
+        x[k] = position[n];
+        y[k] = fEnergy[n];
+        ex[k] = 0;
+        xMin = min(xMin, x[k]);
+        xMax = max(xMax, x[k]);
+        if (y[k] != 0) {
+            ey[k] = 10 * sqrt(y[k]);
         } else {
-            return -1.0;  // the fit failed, return -1 to indicate failure
+            ey[k] = 0;
         }
-
-        delete (grX);
-        delete (fit);
+    }
+    Int_t h = nHits + nAdd / 2;
+    if (doHitCorrection) {
+        x[0] = xMin - 0.5;
+        x[h] = xMax + 0.5;
+        y[0] = 0.0;
+        y[h] = 0.0;
+        ex[0] = 0.0;
+        ex[h] = 0.0;
+        ey[0] = error;
+        ey[h] = error;
+    }
+    TGraphErrors graph(nElems, &x[0], &y[0], &ex[0], &ey[0]);
+    // Defining the starting parameters for the fit.
+    Double_t maxY = MaxElement(nElems, graph.GetY());
+    Double_t maxX = graph.GetX()[LocMax(nElems, graph.GetY())];
+    Double_t sigma = doHitCorrection ? abs(x[0] - x[h]) / 2.0 : (xMax - xMin) / 2.0;
+
+    TF1 fit("", "gaus");
+    fit.SetParameter(0, maxY);
+    fit.SetParameter(1, maxX);
+    fit.SetParameter(2, sigma);
+    TFitResultPtr fitResult =
+        graph.Fit(&fit, "QNBS");  // Q = quiet, no info in screen; N = no plot; B = no automatic start
+                                  // parameters; R = Use the Range specified in the function range; S = save
+                                  // and return the fit result.
+    if (!fitResult->IsValid()) {
+        return -1.0;  // the fit failed, return -1 to indicate failure
     }
 
-    return abs(gausSigmaX);
+    return abs(fit.GetParameter(2));
 }
-/// \brief It computes the gaussian sigma in the Y-coordinate.
-/// It adds a hit to the right and a hit to the left, with energy = 0 +/- user defined error in ADC.
-/// Then it fits a gaussian to the hits and extracts the sigma. The hits are just added
-/// for fitting purposes and do not go into any further processing.
-Double_t TRestHits::GetGaussSigmaY(Double_t error, Int_t nHitsMin) {
-    Double_t gausSigmaY = 0;
-    Int_t nHits = GetNumberOfHits();
+
+namespace {
+// It solves the 3x3 linear system m * x = b by Cramer's rule. It returns false if m is singular.
+bool Solve3x3(const Double_t m[3][3], const Double_t b[3], Double_t x[3]) {
+    auto det = [](const Double_t a[3][3]) {
+        return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+               a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+               a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    };
+
+    Double_t d = det(m);
+    if (d == 0 || !std::isfinite(d)) return false;
+
+    for (int c = 0; c < 3; c++) {
+        Double_t mc[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) mc[i][j] = (j == c) ? b[i] : m[i][j];
+        }
+        x[c] = det(mc) / d;
+    }
+    return true;
+}
+}  // namespace
+
+///////////////////////////////////////////////
+/// \brief It estimates the same gaussian sigma as FitGaussSigma, without creating any
+/// ROOT object.
+///
+/// The weighted least squares problem of the fit (hits with error `10 sqrt(E)` and the
+/// two side hits with error `error`) is solved by Levenberg-Marquardt iterations
+/// computed directly on the hit vectors, starting from the same parameters as the fit.
+/// Hits with a non-positive energy are ignored.
+///
+/// It returns -1 if the estimation does not converge to a finite sigma.
+///
+Double_t TRestHits::EstimateGaussSigma(const std::vector<Float_t>& position, Double_t error,
+                                       Int_t nHitsMin) const {
+    const Int_t nHits = GetNumberOfHits();
     if (nHits <= 0) {
-        gausSigmaY = 0;
-    } else {
-        Int_t nAdd = 0;
-        bool doHitCorrection = nHits <= nHitsMin;
-        if (doHitCorrection) {
-            nAdd = 2;
+        return 0;
+    }
+
+    Double_t xMin = std::numeric_limits<double>::max();
+    Double_t xMax = std::numeric_limits<double>::lowest();
+    Double_t maxY = std::numeric_limits<double>::lowest();
+    Double_t maxX = 0;
+    for (int n = 0; n < nHits; n++) {
+        xMin = min(xMin, (Double_t)position[n]);
+        xMax = max(xMax, (Double_t)position[n]);
+        if (fEnergy[n] > maxY) {
+            maxY = fEnergy[n];
+            maxX = position[n];
         }
-        Int_t nElems = nHits + nAdd;
-        vector<Double_t> x(nElems), y(nElems), ex(nElems), ey(nElems);
-        Int_t k = nAdd / 2;
-        Double_t xMin = std::numeric_limits<double>::max();
-        Double_t xMax = std::numeric_limits<double>::lowest();
-        for (unsigned int n = 0; n < GetNumberOfHits(); k++, n++) {
-            x[k] = fY[n];
-            y[k] = fEnergy[n];
-            ex[k] = 0;
-            xMin = min(xMin, x[k]);
-            xMax = max(xMax, x[k]);
-            if (y[k] != 0) {
-                ey[k] = 10 * sqrt(y[k]);
-            } else {
-                ey[k] = 0;
-            }
+    }
+
+    const bool doHitCorrection = nHits <= nHitsMin;
+    const Double_t sideWeight = (error != 0) ? 1. / (error * error) : 0;
+    // it calls `function(x, y, weight)` for each point of the fit
+    auto forEachPoint = [&](auto&& function) {
+        for (int n = 0; n < nHits; n++) {
+            if (fEnergy[n] > 0) function(position[n], fEnergy[n], 1. / (100. * fEnergy[n]));
         }
-        Int_t h = nHits + nAdd / 2;
-        if (doHitCorrection) {
-            x[0] = xMin - 0.5;
-            x[h] = xMax + 0.5;
-            y[0] = 0.0;
-            y[h] = 0.0;
-            ex[0] = 0.0;
-            ex[h] = 0.0;
-            ey[0] = error;
-            ey[h] = error;
+        if (doHitCorrection && sideWeight > 0) {
+            function(xMin - 0.5, 0., sideWeight);
+            function(xMax + 0.5, 0., sideWeight);
         }
-        TGraphErrors* grY = new TGraphErrors(nElems, &x[0], &y[0], &ex[0], &ey[0]);
-        // TCanvas *c = new TCanvas("c","Y position fit",200,10,500,500);
-        // grY->Draw();
-        // Defining the starting parameters for the fit.
-        Double_t maxY = MaxElement(nElems, grY->GetY());
-        Double_t maxX = grY->GetX()[LocMax(nElems, grY->GetY())];
-        Double_t sigma = abs(x[0] - x[h]) / 2.0;
-
-        TF1* fit = new TF1("", "gaus");
-        fit->SetParameter(0, maxY);
-        fit->SetParameter(1, maxX);
-        fit->SetParameter(2, sigma);
-        TFitResultPtr fitResult =
-            grY->Fit(fit, "QNBS");  // Q = quiet, no info in screen; N = no plot; B = no automatic start
-                                    // parameters; R = Use the Range specified in the function range; S = save
-                                    // and return the fit result.
-        if (fitResult->IsValid()) {
-            gausSigmaY = fit->GetParameter(2);
+    };
+    auto chi2 = [&](const Double_t p[3]) {
+        Double_t result = 0;
+        forEachPoint([&](Double_t x, Double_t y, Double_t w) {
+            Double_t d = (x - p[1]) / p[2];
+            Double_t r = y - p[0] * exp(-0.5 * d * d);
+            result += w * r * r;
+        });
+        return result;
+    };
+
+    // same starting parameters as FitGaussSigma
+    Double_t p[3] = {maxY, maxX, (xMax - xMin) / 2.0 + (doHitCorrection ? 0.5 : 0)};
+    if (p[2] <= 0) {
+        return -1.0;
+    }
+
+    Double_t current = chi2(p);
+    Double_t lambda = 1.e-3;
+    for (int iteration = 0; iteration < 200 && lambda < 1.e10; iteration++) {
+        Double_t jtj[3][3] = {}, jtr[3] = {};
+        forEachPoint([&](Double_t x, Double_t y, Double_t w) {
+            Double_t d = (x - p[1]) / p[2];
+            Double_t g = exp(-0.5 * d * d);
+            Double_t j[3] = {g, p[0] * g * d / p[2], p[0] * g * d * d / p[2]};
+            Double_t r = y - p[0] * g;
+            for (int a = 0; a < 3; a++) {
+                jtr[a] += w * j[a] * r;
+                for (int b = 0; b < 3; b++) jtj[a][b] += w * j[a] * j[b];
+            }
+        });
+        for (int a = 0; a < 3; a++) jtj[a][a] *= 1 + lambda;
+
+        Double_t step[3];
+        if (!Solve3x3(jtj, jtr, step)) break;
+
+        Double_t trial[3] = {p[0] + step[0], p[1] + step[1], p[2] + step[2]};
+        Double_t trialChi2 = (trial[2] != 0) ? chi2(trial) : current;
+        if (trialChi2 < current) {
+            Double_t improvement = (current - trialChi2) / max(current, std::numeric_limits<double>::min());
+            std::copy(trial, trial + 3, p);
+            current = trialChi2;
+            lambda /= 10;
+            if (improvement < 1.e-10) break;
         } else {
-            return -1.0;  // the fit failed, return -1 to indicate failure
+            lambda *= 10;
         }
+    }
 
-        delete (grY);
-        delete (fit);
+    if (!std::isfinite(p[2]) || !std::isfinite(current)) {
+        return -1.0;
     }
 
-    return abs(gausSigmaY);
+    return abs(p[2]);
 }
-/// \brief It computes the gaussian sigma in the Z-coordinate.
+
+///////////////////////////////////////////////
+/// \brief It computes the gaussian sigma in the X-coordinate.
 /// It adds a hit to the right and a hit to the left, with energy = 0 +/- user defined error in ADC.
 /// Then it fits a gaussian to the hits and extracts the sigma. The hits are just added
 /// for fitting purposes and do not go into any further processing.
-Double_t TRestHits::GetGaussSigmaZ(Double_t error, Int_t nHitsMin) {
-    Double_t gausSigmaZ = 0;
-    Int_t nHits = GetNumberOfHits();
-    if (nHits <= 0) {
-        gausSigmaZ = 0;
-    } else {
-        Int_t nAdd = 0;
-        bool doHitCorrection = nHits <= nHitsMin;
-        if (doHitCorrection) {
-            nAdd = 2;
-        }
-        Int_t nElems = nHits + nAdd;
-        vector<Double_t> x(nElems), y(nElems), ex(nElems), ey(nElems);
-        Int_t k = nAdd / 2;
-        Double_t xMin = std::numeric_limits<double>::max();
-        Double_t xMax = std::numeric_limits<double>::lowest();
-        for (unsigned int n = 0; n < GetNumberOfHits(); k++, n++) {
-            x[k] = fZ[n];
-            y[k] = fEnergy[n];
-            ex[k] = 0;
-            xMin = min(xMin, x[k]);
-            xMax = max(xMax, x[k]);
-            if (y[k] != 0) {
-                ey[k] = 10 * sqrt(y[k]);
-            } else {
-                ey[k] = 0;
-            }
-        }
-        Int_t h = nHits + nAdd / 2;
-        if (doHitCorrection) {
-            x[0] = xMin - 0.5;
-            x[h] = xMax + 0.5;
-            y[0] = 0.0;
-            y[h] = 0.0;
-            ex[0] = 0.0;
-            ex[h] = 0.0;
-            ey[0] = error;
-            ey[h] = error;
-        }
-        TGraphErrors* grZ = new TGraphErrors(nElems, &x[0], &y[0], &ex[0], &ey[0]);
-        // TCanvas *c = new TCanvas("c","Z position fit",200,10,500,500);
-        // grZ->Draw();
-        // Defining the starting parameters for the fit.
-        Double_t maxY = MaxElement(nElems, grZ->GetY());
-        Double_t maxX = grZ->GetX()[LocMax(nElems, grZ->GetY())];
-        Double_t sigma = abs(x[0] - x[h]) / 2.0;
-
-        TF1* fit = new TF1("", "gaus");
-        fit->SetParameter(0, maxY);
-        fit->SetParameter(1, maxX);
-        fit->SetParameter(2, sigma);
-        TFitResultPtr fitResult =
-            grZ->Fit(fit, "QNBS");  // Q = quiet, no info in screen; N = no plot; B = no automatic start
-                                    // parameters; R = Use the Range specified in the function range; S = save
-                                    // and return the fit result.
-        if (fitResult->IsValid()) {
-            gausSigmaZ = fit->GetParameter(2);
-        } else {
-            return -1.0;  // the fit failed, return -1 to indicate failure
-        }
+///
+/// If `fast` is true the sigma is computed by EstimateGaussSigma, which solves the same
+/// fit without creating ROOT objects, instead of a TF1 fit.
+///
+Double_t TRestHits::GetGaussSigmaX(Double_t error, Int_t nHitsMin, Bool_t fast) {
+    return fast ? EstimateGaussSigma(fX, error, nHitsMin) : FitGaussSigma(fX, error, nHitsMin);
+}
 
-        delete (grZ);
-        delete (fit);
-    }
+///////////////////////////////////////////////
+/// \brief It computes the gaussian sigma in the Y-coordinate. See GetGaussSigmaX.
+///
+Double_t TRestHits::GetGaussSigmaY(Double_t error, Int_t nHitsMin, Bool_t fast) {
+    return fast ? EstimateGaussSigma(fY, error, nHitsMin) : FitGaussSigma(fY, error, nHitsMin);
+}
 
-    return abs(gausSigmaZ);
+///////////////////////////////////////////////
+/// \brief It computes the gaussian sigma in the Z-coordinate. See GetGaussSigmaX.
+///
+Double_t TRestHits::GetGaussSigmaZ(Double_t error, Int_t nHitsMin, Bool_t fast) {
+    return fast ? EstimateGaussSigma(fZ, error, nHitsMin) : FitGaussSigma(fZ, error, nHitsMin);
 }
 
 ///////////////////////////////////////////////
@@ -450,6 +450,9 @@
 /// 2017-Aug:  Major change to xml reading and class startup procedure
 ///            Kaixiang Ni
 ///
+/// 2026-October: For loop variables passed down as linked scopes, parsed rml
+///            files reused while unmodified, and variables replaced in one scan.
+///
 /// \class      TRestMetadata
 /// \author     Igor Irastorza
 /// \author     Javier Galan
@@ -464,7 +467,10 @@
 #include <TMath.h>
 #include <TStreamerInfo.h>
 
+#include <filesystem>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 
 #include "TRestDataBase.h"
 
@@ -486,6 +492,38 @@ using namespace REST_Physics;
 
 map<string, string> TRestMetadata_UpdatedConfigFile;
 
+namespace {
+// The rml files already parsed, by file name. A file is parsed again only if its
+// modification time or size change. The documents are never modified, only cloned.
+struct ParsedConfigFile {
+    std::filesystem::file_time_type modificationTime;
+    std::uintmax_t size;
+    std::shared_ptr<TiXmlDocument> document;
+};
+std::mutex parsedConfigFilesMutex;
+map<string, ParsedConfigFile> parsedConfigFiles;
+
+// It returns the parsed document of `filename`, or nullptr if it has a wrong syntax
+std::shared_ptr<TiXmlDocument> GetParsedConfigFile(const string& filename) {
+    std::error_code timeError, sizeError;
+    auto modificationTime = std::filesystem::last_write_time(filename, timeError);
+    auto size = std::filesystem::file_size(filename, sizeError);
+    bool cacheable = !timeError && !sizeError;
+
+    std::lock_guard<std::mutex> lock(parsedConfigFilesMutex);
+    auto parsed = parsedConfigFiles.find(filename);
+    if (cacheable && parsed != parsedConfigFiles.end() &&
+        parsed->second.modificationTime == modificationTime && parsed->second.size == size) {
+        return parsed->second.document;
+    }
+
+    auto document = std::make_shared<TiXmlDocument>();
+    if (!document->LoadFile(filename.c_str())) return nullptr;
+    if (cacheable) parsedConfigFiles[filename] = {modificationTime, size, document};
+    return document;
+}
+}  // namespace
+
 ClassImp(TRestMetadata);
 ///////////////////////////////////////////////
 /// \brief TRestMetadata default constructor
@@ -885,7 +923,7 @@ TiXmlElement* TRestMetadata::ReplaceElementAttributes(TiXmlElement* e) {
         // for name attribute, don't replace constants
         if (strcmp(name, "name") != 0) newVal = ReplaceConstants(newVal);
 
-        e->SetAttribute(name, ReplaceMathematicalExpressions(newVal));
+        attr->SetValue(ReplaceMathematicalExpressions(newVal));
 
         attr = attr->Next();
     }
@@ -951,7 +989,7 @@ void TRestMetadata::ReadElement(TiXmlElement* e, bool recursive) {
     ReadEnvInElement(e);
 
     if ((string)e->Value() == "for") {
-        ExpandForLoops(e, {});
+        ExpandForLoops(e);
     } else if (e->Attribute("file") != nullptr) {
         ExpandIncludeFile(e);
     } else if ((string)e->Value() == "if") {
@@ -1087,7 +1125,7 @@ void TRestMetadata::ExpandIfSections(TiXmlElement* e) {
 
 ///////////////////////////////////////////////
 /// \brief Helper method for TRestMetadata::ExpandForLoops().
-void TRestMetadata::ExpandForLoopOnce(TiXmlElement* e, const map<string, string>& forLoopVar) {
+void TRestMetadata::ExpandForLoopOnce(TiXmlElement* e, const ForLoopScope* scope) {
     if (e == nullptr) {
         return;
     }
@@ -1101,11 +1139,11 @@ void TRestMetadata::ExpandForLoopOnce(TiXmlElement* e, const map<string, string>
             TiXmlElement* tempnew = (TiXmlElement*)parele->InsertBeforeChild(e, *newforloop);
             delete newforloop;
             newforloop = tempnew;
-            ExpandForLoops(newforloop, forLoopVar);
+            ExpandForLoops(newforloop, scope);
             contentelement = contentelement->NextSiblingElement();
         } else {
             TiXmlElement* attachedelement = (TiXmlElement*)contentelement->Clone();
-            ReplaceForLoopVars(attachedelement, forLoopVar);
+            ReplaceForLoopVars(attachedelement, scope);
             ReadElement(attachedelement, true);
             // RESTDebug << *attachedelement << RESTendl;
             parele->InsertBeforeChild(e, *attachedelement);
@@ -1118,7 +1156,10 @@ void TRestMetadata::ExpandForLoopOnce(TiXmlElement* e, const map<string, string>
 ///////////////////////////////////////////////
 /// \brief Helper method for TRestMetadata::ExpandForLoops().
 ///
-void TRestMetadata::ReplaceForLoopVars(TiXmlElement* e, map<string, string> forLoopVar) {
+/// It replaces the marks `{VARIABLE}` by the value of the loop variable VARIABLE, looked up
+/// from `scope` to its enclosing loops.
+///
+void TRestMetadata::ReplaceForLoopVars(TiXmlElement* e, const ForLoopScope* scope) {
     if (e == nullptr) return;
 
     RESTDebug << "Entering ... TRestMetadata::ReplaceForLoopVars" << RESTendl;
@@ -1156,11 +1197,12 @@ void TRestMetadata::ReplaceForLoopVars(TiXmlElement* e, map<string, string> forL
                 int replacePos = startPosition;
                 int replaceLen = endPosition - startPosition + 1;
 
-                string proenv = forLoopVar.count(expression) > 0 ? forLoopVar[expression] : "";
+                const string* proenv = scope != nullptr ? scope->Find(expression) : nullptr;
 
-                if (!proenv.empty()) {
-                    outputBuffer.replace(replacePos, replaceLen, proenv);
-                    endPosition = 0;
+                if (proenv != nullptr && !proenv->empty()) {
+                    outputBuffer.replace(replacePos, replaceLen, *proenv);
+                    // the text before the replaced mark has no "{" left
+                    endPosition = startPosition;
                 } else {
                     RESTError << this->ClassName() << ", replace for loop env : cannot find \"{" << expression
                               << "}\"" << RESTendl;
@@ -1185,7 +1227,10 @@ void TRestMetadata::ReplaceForLoopVars(TiXmlElement* e, map<string, string> forL
 /// them in the given xml section. Loop variable is treated samely as REST
 /// "variable"
 ///
-void TRestMetadata::ExpandForLoops(TiXmlElement* e, map<string, string> forloopvar) {
+/// The loop variables of the enclosing loops are reached through `parentScope`, without
+/// copying them.
+///
+void TRestMetadata::ExpandForLoops(TiXmlElement* e, const ForLoopScope* parentScope) {
     if (e == nullptr) return;
     if ((string)e->Value() != "for") return;
     RESTDebug << "Entering ... ExpandForLoops" << RESTendl;
@@ -1211,6 +1256,7 @@ void TRestMetadata::ExpandForLoops(TiXmlElement* e, map<string, string> forloopv
     string _step = (string)varstep;
     string _in = (string)varin;
     RESTDebug << "_from: " << _from << " _to: " << _to << " _step: " << _step << RESTendl;
+    ForLoopScope scope{_name, "", parentScope};
     if (isANumber(_from) && isANumber(_to) && isANumber(_step)) {
         double from = StringToDouble(_from);
         double to = StringToDouble(_to);
@@ -1219,9 +1265,9 @@ void TRestMetadata::ExpandForLoops(TiXmlElement* e, map<string, string> forloopv
         RESTDebug << "----expanding for loop----" << RESTendl;
         double i = 0;
         for (i = from; i <= to; i = i + step) {
-            forloopvar[_name] = ToString(i);
-            fVariables[_name] = ToString(i);
-            ExpandForLoopOnce(e, forloopvar);
+            scope.value = ToString(i);
+            fVariables[_name] = scope.value;
+            ExpandForLoopOnce(e, &scope);
         }
         parele->RemoveChild(e);
 
@@ -1232,9 +1278,9 @@ void TRestMetadata::ExpandForLoops(TiXmlElement* e, map<string, string> forloopv
 
         RESTDebug << "----expanding for loop----" << RESTendl;
         for (const string& loopvar : loopvars) {
-            forloopvar[_name] = loopvar;
+            scope.value = loopvar;
             fVariables[_name] = loopvar;
-            ExpandForLoopOnce(e, forloopvar);
+            ExpandForLoopOnce(e, &scope);
         }
         parele->RemoveChild(e);
 
@@ -1682,6 +1728,35 @@ TVector3 TRestMetadata::Get3DVectorParameterWithUnits(std::string parName, TVect
     return defaultVal;
 }
 
+///////////////////////////////////////////////
+/// \brief Checks that the units given to the parameter **parName** have the dimension of
+/// **expectedUnits**.
+///
+/// It is meant to be called from InitFromConfigFile(), so that a parameter given e.g. in "keV"
+/// instead of "keV/mm" is reported when the config file is loaded:
+///
+/// \code
+/// CheckParameterUnits("electricField", "V/cm");
+/// fElectricField = GetDblParameterWithUnits("electricField");
+/// \endcode
+///
+/// A parameter which is not found, or given without units (then it is already in REST units), is
+/// accepted.
+///
+/// \return false, after printing an error, if the units do not match.
+///
+Bool_t TRestMetadata::CheckParameterUnits(const std::string& parName, const std::string& expectedUnits) {
+    string unit = GetParameterAndUnits(parName).second;
+    if (unit.empty() || REST_Units::AreCompatibleUnits(unit, expectedUnits)) {
+        return true;
+    }
+
+    RESTError << ClassName() << ": parameter \"" << parName << "\" is given in \"" << unit
+              << "\", which cannot be converted to \"" << expectedUnits << "\" ("
+              << REST_Units::GetStandardUnitDefinition(expectedUnits) << ")" << RESTendl;
+    return false;
+}
+
 ///////////////////////////////////////////////
 /// \brief Open an xml encoded file and find its element.
 ///
@@ -1697,8 +1772,10 @@ TVector3 TRestMetadata::Get3DVectorParameterWithUnits(std::string parName, TVect
 /// Exits the whole program if the xml file does not exist, or is in wrong in
 /// syntax. Returns NULL if no element matches NameOrDecalre
 ///
+/// The parsed files are kept, so a file included many times is only parsed again
+/// if it is modified.
+///
 TiXmlElement* TRestMetadata::GetElementFromFile(std::string configFilename, std::string NameOrDeclare) {
-    TiXmlDocument doc;
     TiXmlElement* rootele;
 
     string filename = configFilename;
@@ -1710,12 +1787,13 @@ TiXmlElement* TRestMetadata::GetElementFromFile(std::string configFilename, std:
         exit(1);
     }
 
-    if (!doc.LoadFile(filename.c_str())) {
+    auto doc = GetParsedConfigFile(filename);
+    if (doc == nullptr) {
         RESTError << "Failed to load xml file, syntax maybe wrong. The file is: " << filename << RESTendl;
         exit(1);
     }
 
-    rootele = doc.RootElement();
+    rootele = doc->RootElement();
     if (rootele == nullptr) {
         RESTError << "The rml file \"" << configFilename << "\" does not contain any valid elements!"
                   << RESTendl;
@@ -2125,15 +2203,17 @@ string TRestMetadata::ReplaceVariables(const string buffer) {
         string proenv = fVariables.count(expression) > 0 ? fVariables[expression] : "";
         string argenv = REST_ARGS.count(expression) > 0 ? REST_ARGS[expression] : "";
 
+        // the text before the replaced mark has no "${" left, but a "$" just before it may
+        // form a new one with the replacement
         if (sysenv != "") {
             outputBuffer.replace(replacePos, replaceLen, sysenv);
-            endPosition = 0;
+            endPosition = max(startPosition - 1, 0);
         } else if (argenv != "") {
             outputBuffer.replace(replacePos, replaceLen, argenv);
-            endPosition = 0;
+            endPosition = max(startPosition - 1, 0);
         } else if (proenv != "") {
             outputBuffer.replace(replacePos, replaceLen, proenv);
-            endPosition = 0;
+            endPosition = max(startPosition - 1, 0);
         } else {
             RESTError << this->ClassName() << ", replace env : cannot find \"${" << expression
                       << "}\" in either system or program env, exiting..." << RESTendl;
@@ -2605,8 +2685,8 @@ void TRestMetadata::ReadOneParameter(string name, string value) {
 
                 int mindiff = 100;
                 string hintParameter = "";
-                for (auto parameter : availableparameters) {
-                    int diff = DiffString(name, parameter);
+                for (const auto& parameter : availableparameters) {
+                    int diff = DiffString(name, parameter, 2);
                     if (diff < mindiff) {
                         mindiff = diff;
                         hintParameter = parameter;
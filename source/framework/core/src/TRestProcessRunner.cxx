@@ -24,6 +24,11 @@
 
 #include <TGeoManager.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <new>
+
 #include "Math/MinimizerOptions.h"
 #include "TBranchRef.h"
 #include "TInterpreter.h"
@@ -40,6 +45,12 @@
 #endif  // !WIN32
 
 std::mutex mutex_write;
+// notified when the sorted output advances, see TRestProcessRunner::FillThreadEventFunc
+std::condition_variable outputWritten;
+// notified when fProcStatus changes, and when the threads pause or end
+std::condition_variable runnerStatusChanged;
+int threadsPaused = 0;  // number of threads waiting in GetNextevtFunc() for the pause to end
+int threadsEnded = 0;   // number of threads that got the last event already
 
 using namespace std;
 #ifdef TIME_MEASUREMENT
@@ -60,9 +71,141 @@ vector<Double_t> progAdded(ncalculated, 0);
 int positionCalculated = 0;
 int printInterval = 200000;  // 0.2s
 int inputTreeEntries = 0;
+std::atomic<Long64_t> inputEntriesRead(0);
 
 ClassImp(TRestProcessRunner);
 
+///////////////////////////////////////////////
+/// \brief A precomputed list of copies between two sets of observables.
+///
+/// Trivially copyable observables are copied with memcpy. Consecutive
+/// observables that are also contiguous in memory, both at the origin and at
+/// the destination, are merged into a single block. The rest of observables
+/// are copied through RESTValue.
+///
+/// The plan stays valid as long as the observables are not re-allocated,
+/// which is the case once the output analysis tree has been filled.
+///
+struct TRestProcessRunner::ObservableCopyPlan {
+    struct Block {
+        char* from;
+        char* to;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<std::pair<RESTValue, RESTValue>> objects;
+    /// The number of observables covered by the plan, -1 if it is not built
+    Int_t nObservables = -1;
+
+    void Build(const std::vector<RESTValue>& from, const std::vector<RESTValue>& to) {
+        blocks.clear();
+        objects.clear();
+        size_t n = std::min(from.size(), to.size());
+        for (size_t i = 0; i < n; i++) {
+            if (from[i].is_data_type && from[i].IsSameType(to[i])) {
+                if (!blocks.empty() && blocks.back().from + blocks.back().size == from[i].address &&
+                    blocks.back().to + blocks.back().size == to[i].address) {
+                    blocks.back().size += from[i].size;
+                } else {
+                    blocks.push_back({from[i].address, to[i].address, (size_t)from[i].size});
+                }
+            } else {
+                objects.emplace_back(from[i], to[i]);
+            }
+        }
+        nObservables = n;
+    }
+
+    void Copy() {
+        for (const auto& block : blocks) memcpy(block.to, block.from, block.size);
+        for (auto& obj : objects) obj.first >> obj.second;
+    }
+};
+
+/// It returns the observables of the tree, pointing to the tree memory
+static vector<RESTValue> GetObservableList(TRestAnalysisTree* tree) {
+    vector<RESTValue> list;
+    for (int n = 0; n < tree->GetNumberOfObservables(); n++) list.push_back(tree->GetObservable(n));
+    return list;
+}
+
+///////////////////////////////////////////////
+/// \brief A copy of the output of a thread for one event: event info,
+/// observables and the objects stored in the event tree branches.
+///
+/// It allows the thread to continue processing while its event waits for
+/// the previous input entries to be written. The slots are recycled, so the
+/// observables and events are only allocated once.
+///
+struct TRestProcessRunner::OutputSlot {
+    Int_t runOrigin = 0;
+    Int_t subRunOrigin = 0;
+    Int_t eventID = 0;
+    Int_t subEventID = 0;
+    Double_t timeStamp = 0;
+    TString subEventTag;
+
+    std::vector<RESTValue> observables;
+    std::vector<TRestEvent*> events;
+
+    /// The copy plans from the analysis tree of each thread, by thread id
+    std::vector<ObservableCopyPlan> fromThread;
+    /// The copy plan to the output analysis tree
+    ObservableCopyPlan toOutput;
+
+    void CopyFrom(TRestThread* t) {
+        TRestEvent* evt = t->GetOutputEvent();
+        runOrigin = evt->GetRunOrigin();
+        subRunOrigin = evt->GetSubRunOrigin();
+        eventID = evt->GetID();
+        subEventID = evt->GetSubID();
+        timeStamp = evt->GetTimeStamp().AsDouble();
+        subEventTag = evt->GetSubEventTag();
+
+        TRestAnalysisTree* tree = t->GetAnalysisTree();
+        if ((int)fromThread.size() <= t->GetThreadId()) fromThread.resize(t->GetThreadId() + 1);
+        ObservableCopyPlan& plan = fromThread[t->GetThreadId()];
+        if (plan.nObservables != tree->GetNumberOfObservables()) {
+            std::vector<RESTValue> source = GetObservableList(tree);
+            for (unsigned int n = 0; n < source.size(); n++) {
+                if (n < observables.size() && !observables[n].IsSameType(source[n])) {
+                    // the re-allocated observable invalidates all the plans
+                    observables[n].Destroy();
+                    observables[n] = REST_Reflection::Assembly(source[n].type);
+                    observables[n].name = source[n].name;
+                    for (auto& p : fromThread) p.nObservables = -1;
+                    toOutput.nObservables = -1;
+                } else if (n == observables.size()) {
+                    observables.push_back(REST_Reflection::Assembly(source[n].type));
+                    observables.back().name = source[n].name;
+                }
+            }
+            plan.Build(source, observables);
+        }
+        plan.Copy();
+
+        TTree* eventTree = t->GetEventTree();
+        if (eventTree != nullptr) {
+            TObjArray* branches = eventTree->GetListOfBranches();
+            for (int i = 0; i < branches->GetLast() + 1; i++) {
+                // for TBranchElement the saved address is char**
+                auto source = *(TRestEvent**)((TBranch*)branches->UncheckedAt(i))->GetAddress();
+                if (i == (int)events.size()) {
+                    events.push_back((TRestEvent*)source->Clone());
+                } else {
+                    source->CloneTo(events[i]);
+                }
+            }
+        }
+    }
+
+    ~OutputSlot() {
+        for (auto& obs : observables) obs.Destroy();
+        for (auto evt : events) delete evt;
+    }
+};
+
 TRestProcessRunner::TRestProcessRunner() { Initialize(); }
 
 TRestProcessRunner::~TRestProcessRunner() {}
@@ -85,6 +228,7 @@ void TRestProcessRunner::Initialize() {
     fThreadNumber = 0;
     fFirstEntry = 0;
     fNFilesSplit = 0;
+    fNextOutputEntry = 0;
     fEventsToProcess = 0;
     fProcessedEvents = 0;
     fProcessNumber = 0;
@@ -100,6 +244,7 @@ void TRestProcessRunner::Initialize() {
     fInputEventStorage = true;
     fOutputEventStorage = true;
     fOutputAnalysisStorage = true;
+    fParallelCompression = true;
 }
 
 ///////////////////////////////////////////////
@@ -401,6 +546,27 @@ void TRestProcessRunner::RunProcess() {
         fEventTree = nullptr;
     }
 
+    // The output event tree branches are bound once to fEventTreeObjects. Writing an event only
+    // changes the pointers, and ROOT updates the branch addresses if the object is different.
+    fThreadEventObjects.assign(fThreadNumber, {});
+    for (int i = 0; i < fThreadNumber; i++) {
+        if (fThreads[i]->GetEventTree() == nullptr) continue;
+        TObjArray* branches = fThreads[i]->GetEventTree()->GetListOfBranches();
+        for (int j = 0; j < branches->GetLast() + 1; j++) {
+            // for TBranchElement the saved address is char**
+            TBranch* branch = (TBranch*)branches->UncheckedAt(j);
+            fThreadEventObjects[i].push_back(*(TRestEvent**)branch->GetAddress());
+        }
+    }
+    fEventTreeObjects.clear();
+    if (fEventTree != nullptr) {
+        fEventTreeObjects = fThreadEventObjects[0];
+        TObjArray* branches = fEventTree->GetListOfBranches();
+        for (unsigned int j = 0; j < fEventTreeObjects.size(); j++) {
+            ((TBranch*)branches->UncheckedAt(j))->SetAddress(&fEventTreeObjects[j]);
+        }
+    }
+
     // initialize analysis tree
     fAnalysisTree = new TRestAnalysisTree("AnalysisTree", "REST Process Analysis Tree");
     fAnalysisTree->SetDirectory(fOutputDataFile);
@@ -429,13 +595,42 @@ void TRestProcessRunner::RunProcess() {
     fRunInfo->ResetEntry();
     fRunInfo->SetCurrentEntry(fFirstEntry);
     inputTreeEntries = fRunInfo->GetEntries();
+    inputEntriesRead = 0;
+    threadsPaused = 0;
+    threadsEnded = 0;
+    fNextOutputEntry = 0;
+    fPendingOutput.clear();
+    // the copy plans point to the observables of the previous run
+    fOutputSlots.clear();
+    fFreeOutputSlots.clear();
+    fThreadCopyPlans.assign(fThreadNumber, ObservableCopyPlan());
+
+    // The output trees are filled under the write lock. With implicit multi-threading the
+    // baskets are compressed by ROOT tasks, so that the compression cost at high compression
+    // levels is shared among the cores instead of running on the thread holding the lock.
+    bool implicitMT = false;
+    if (fParallelCompression && fThreadNumber > 1) {
+        if (!ROOT::IsImplicitMTEnabled()) {
+            ROOT::EnableImplicitMT(fThreadNumber);
+            implicitMT = ROOT::IsImplicitMTEnabled();
+        }
+        if (fEventTree != nullptr) fEventTree->SetImplicitMT(true);
+        fAnalysisTree->SetImplicitMT(true);
+    }
 
     // set root mutex
     //!!!!!!!!!!!!Important!!!!!!!!!!!!
     ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit");
     TMinuitMinimizer::UseStaticMinuit(false);
+    // The full split files are closed in the background while the threads keep running, so ROOT
+    // must protect its global state. Thread safety is enabled before the threads start, as doing it
+    // later would replace the global mutex while they may hold it
+    if (fOutputDataFile != nullptr) ROOT::EnableThreadSafety();
+    // ROOT already defines its global mutex if thread safety has been enabled
+    TVirtualMutex* restMutex = nullptr;
     if (gGlobalMutex == nullptr) {
-        gGlobalMutex = new TMutex(true);
+        restMutex = new TMutex(true);
+        gGlobalMutex = restMutex;
         gROOTMutex = gGlobalMutex;
         gInterpreterMutex = gGlobalMutex;
     }
@@ -459,8 +654,12 @@ void TRestProcessRunner::RunProcess() {
             int a = Console::ReadKey();  // get char
 
             if (a == 'p') {
-                fProcStatus = kPause;
-                usleep(100000);  // wait 0.1s for the processes to finish;
+                SetProcStatus(kPause);
+                // the threads finish the events they are processing, then stop at the next read
+                std::unique_lock<std::mutex> lock(mutex_write);
+                runnerStatusChanged.wait(lock,
+                                         [&] { return threadsPaused + threadsEnded == fThreadNumber; });
+                lock.unlock();
                 TRestStringOutput RESTLog(TRestStringOutput::REST_Verbose_Level::REST_Silent, COLOR_BOLDWHITE,
                                           "| |", TRestStringOutput::REST_Display_Orientation::kMiddle);
                 Console::ClearLinesAfterCursor();
@@ -479,7 +678,16 @@ void TRestProcessRunner::RunProcess() {
             break;
         }
 
-        usleep(printInterval);
+        // refresh the progress bar at the print interval, or leave as soon as the
+        // last event is written
+        std::unique_lock<std::mutex> lock(mutex_write);
+        bool ended = runnerStatusChanged.wait_for(lock, std::chrono::microseconds(printInterval), [&] {
+            return threadsEnded == fThreadNumber || fProcessedEvents >= fEventsToProcess ||
+                   fProcStatus == kPause;
+        });
+        if (ended && threadsEnded == fThreadNumber) {
+            break;
+        }
 
         // cout << eventsToProcess << " " << fProcessedEvents << " " << lastEntry <<
         // " " << fCurrentEvent << endl; cout << fProcessedEvents << "\r";
@@ -492,14 +700,10 @@ void TRestProcessRunner::RunProcess() {
 
     RESTEssential << "Waiting for processes to finish ..." << RESTendl;
 
-    while (true) {
-        usleep(100000);
-        bool finish = fThreads[0]->Finished();
-        for (int i = 1; i < fThreadNumber; i++) {
-            finish = finish && fThreads[i]->Finished();
-        }
-        if (finish) break;
+    for (int i = 0; i < fThreadNumber; i++) {
+        fThreads[i]->JoinThread();
     }
+    JoinSplitFileWriters();
 
     // make dummy analysis tree filled with observables
     fAnalysisTree->GetEntry(fAnalysisTree->GetEntries() - 1);
@@ -518,10 +722,13 @@ void TRestProcessRunner::RunProcess() {
 #endif
 
     // reset the mutex to null
-    delete gGlobalMutex;
-    gGlobalMutex = nullptr;
-    gROOTMutex = nullptr;
-    gInterpreterMutex = nullptr;
+    if (restMutex != nullptr && gGlobalMutex == restMutex) {
+        delete gGlobalMutex;
+        gGlobalMutex = nullptr;
+        gROOTMutex = nullptr;
+        gInterpreterMutex = nullptr;
+    }
+    if (implicitMT) ROOT::DisableImplicitMT();
 
     RESTcout << this->ClassName() << ": " << fProcessedEvents << " processed events" << RESTendl;
 
@@ -673,6 +880,10 @@ void TRestProcessRunner::PauseMenu() {
 #ifdef WIN32
             RESTWarning << "fork not available on windows!" << RESTendl;
 #else
+            // the child process cannot join the writer threads of its parent
+            JoinSplitFileWriters();
+            // the child inherits the write lock held by this thread, in a known state
+            mutex_write.lock();
             pid_t pid;
             pid = fork();
             if (pid < 0) {
@@ -683,6 +894,24 @@ void TRestProcessRunner::PauseMenu() {
             if (pid == 0) {
                 RESTcout << "Child process created! pid: " << getpid() << RESTendl;
                 RESTInfo << "Restarting threads" << RESTendl;
+                // the ROOT task pool is not inherited by the child process
+                fAnalysisTree->SetImplicitMT(false);
+                if (fEventTree != nullptr) fEventTree->SetImplicitMT(false);
+                // the events being processed by the threads of the father process are lost
+                for (auto& pending : fPendingOutput) {
+                    if (pending.second != nullptr) {
+                        WriteOutputSlot(pending.second);
+                        fFreeOutputSlots.push_back(pending.second);
+                    }
+                }
+                fPendingOutput.clear();
+                fNextOutputEntry = inputEntriesRead;
+                for (auto th : fThreads) th->SetInputEntry(-1);
+                // the condition variables still count the threads of the father process as waiting
+                new (&outputWritten) std::condition_variable();
+                new (&runnerStatusChanged) std::condition_variable();
+                threadsPaused = 0;
+                threadsEnded = 0;
                 mutex_write.unlock();
                 for (int i = 0; i < fThreadNumber; i++) {
                     fThreads[i]->StartThread();
@@ -696,29 +925,29 @@ void TRestProcessRunner::PauseMenu() {
             else {
                 exit(0);
             }
-            fProcStatus = kNormal;
+            SetProcStatus(kNormal);
             RESTInfo << "Continue processing..." << RESTendl;
 
 #endif  // WIN32
 
             break;
         } else if (b == 'n') {
-            fProcStatus = kStep;
+            SetProcStatus(kStep);
             break;
         } else if (b == 'l') {
             // Console::ClearScreen();
             fOutputEvent->PrintEvent();
             break;
         } else if (b == 'q') {
-            fProcStatus = kStopping;
+            SetProcStatus(kStopping);
             break;
         } else if (b == 'p') {
             Console::CursorUp(menuupper);
             Console::ClearLinesAfterCursor();
             if (fVerboseLevel >= TRestStringOutput::REST_Verbose_Level::REST_Debug) {
-                fProcStatus = kIgnore;
+                SetProcStatus(kIgnore);
             } else {
-                fProcStatus = kNormal;
+                SetProcStatus(kNormal);
             }
             break;
         } else if (b == '\n') {
@@ -733,6 +962,18 @@ void TRestProcessRunner::PauseMenu() {
     }
 }
 
+///////////////////////////////////////////////
+/// \brief Changes the process status, and wakes up the threads waiting for it.
+///
+/// The caller must not hold the write lock.
+void TRestProcessRunner::SetProcStatus(ProcStatus status) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_write);
+        fProcStatus = status;
+    }
+    runnerStatusChanged.notify_all();
+}
+
 ///////////////////////////////////////////////
 /// \brief Get next event and copy it to the address of **targetevt**.
 ///
@@ -740,7 +981,8 @@ void TRestProcessRunner::PauseMenu() {
 /// the local analysis tree.
 ///
 /// This method is locked by mutex. There can never be two of it running
-/// simultaneously in two threads.
+/// simultaneously in two threads. While the process is paused, the calling
+/// thread waits here until it is resumed.
 ///
 /// If there is a single thread process, the local input event will be set to
 /// the out put of this process. The **targettree** will not be changed.
@@ -756,10 +998,17 @@ void TRestProcessRunner::PauseMenu() {
 /// thread process stops to give a concret pointer as the output, the process is
 /// over. This method returns -1.
 ///
-Int_t TRestProcessRunner::GetNextevtFunc(TRestEvent* targetevt, TRestAnalysisTree* targettree) {
-    mutex_write.lock();  // lock on
-    while (fProcStatus == kPause) {
-        usleep(100000);
+/// If a **thread** is given, the position of the event in the reading sequence
+/// is assigned to it. See TRestProcessRunner::GetFirstUnfinishedEntry.
+///
+Int_t TRestProcessRunner::GetNextevtFunc(TRestEvent* targetevt, TRestAnalysisTree* targettree,
+                                         TRestThread* thread) {
+    std::unique_lock<std::mutex> lock(mutex_write);
+    if (fProcStatus == kPause) {
+        threadsPaused++;
+        runnerStatusChanged.notify_all();
+        runnerStatusChanged.wait(lock, [&] { return fProcStatus != kPause; });
+        threadsPaused--;
     }
 #ifdef TIME_MEASUREMENT
     high_resolution_clock::time_point t1 = high_resolution_clock::now();
@@ -774,173 +1023,273 @@ Int_t TRestProcessRunner::GetNextevtFunc(TRestEvent* targetevt, TRestAnalysisTre
             n = fRunInfo->GetNextEvent(targetevt, targettree);
         }
     }
+    if (thread != nullptr && n == 0) {
+        // the entry is assigned to the thread before it is counted as read, so that
+        // GetFirstUnfinishedEntry() never sees it read but not in progress
+        const Long64_t entry = inputEntriesRead;
+        thread->SetInputEntry(entry);
+        inputEntriesRead = entry + 1;
+    } else if (thread != nullptr) {
+        thread->SetInputEntry(-1);
+    }
+    if (thread != nullptr && n != 0) {
+        // the thread has written all its events, and will end
+        threadsEnded++;
+        runnerStatusChanged.notify_all();
+    }
 
 #ifdef TIME_MEASUREMENT
     high_resolution_clock::time_point t2 = high_resolution_clock::now();
     readTime += (int)duration_cast<microseconds>(t2 - t1).count();
 #endif
-    mutex_write.unlock();
     return n;
 }
 
 ///////////////////////////////////////////////
-/// \brief Calling back the FillEvent() method in TRestThread.
+/// \brief Writes the output of the given thread to the output trees.
 ///
-/// This method is locked by mutex. There can never be two of it running
-/// simultaneously in two threads. As a result threads will not write their
-/// files together, thus preventing segmentaion violation.
+/// The writing is locked by mutex. There can never be two threads writing
+/// simultaneously, thus preventing segmentaion violation.
+///
+/// If fSortOutputEvents is enabled, the events are written in the order they
+/// were read from the input. A thread whose input entry is not the next one to
+/// be written copies its output into a slot of a bounded reorder buffer and
+/// continues processing. The thread delivering the next input entry writes
+/// its own event and then all the consecutive entries waiting in the buffer.
+/// A thread only waits if all the slots are in use.
 void TRestProcessRunner::FillThreadEventFunc(TRestThread* t) {
-    if (fSortOutputEvents) {
-        // Make sure the thread has the minimum event id in the all the
-        // threads. Otherwise, just wait.
-        while (true) {
-            bool smallest = true;
-            for (TRestThread* otherT : fThreads) {
-                if (otherT->Finished()) {
-                    continue;
-                }
-                if (t->GetThreadId() == otherT->GetThreadId()) {
-                    continue;
-                }
-                int id1 = t->GetInputEvent()->GetID();
-                int id2 = otherT->GetInputEvent()->GetID();
-                if (id1 > id2) {
-                    smallest = false;
-                } else if (id1 == id2) {
-                    cout << "warning! Two events with same event id! output events maybe dis-ordered!"
-                         << endl;
-                }
-            }
+    Long64_t entry = t->GetInputEntry();
+    if (!fSortOutputEvents || entry < 0) {
+        mutex_write.lock();
+        WriteThreadEvent(t);
+        mutex_write.unlock();
+        return;
+    }
 
-            if (smallest) break;
-            usleep(1);
+    bool cut = t->GetOutputEvent() == nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex_write);
+    const size_t maxSlots = 2 * fThreads.size();
+    outputWritten.wait(lock, [&] {
+        return entry == fNextOutputEntry || cut || !fFreeOutputSlots.empty() ||
+               fOutputSlots.size() < maxSlots;
+    });
+
+    if (entry == fNextOutputEntry) {
+        WriteThreadEvent(t);
+        fNextOutputEntry++;
+        WritePendingOutput();
+        lock.unlock();
+        outputWritten.notify_all();
+        return;
+    }
+
+    OutputSlot* slot = nullptr;
+    if (!cut) {
+        if (fFreeOutputSlots.empty()) {
+            fOutputSlots.push_back(std::make_unique<OutputSlot>());
+            fFreeOutputSlots.push_back(fOutputSlots.back().get());
         }
+        slot = fFreeOutputSlots.back();
+        fFreeOutputSlots.pop_back();
+
+        // the copy does not need the lock, the slot now belongs to this thread
+        lock.unlock();
+        slot->CopyFrom(t);
+        lock.lock();
     }
 
-    // Start event saving, entering mutex lock region.
-    mutex_write.lock();
-#ifdef TIME_MEASUREMENT
-    high_resolution_clock::time_point t5 = high_resolution_clock::now();
-#endif
-    if (t->GetOutputEvent() != nullptr) {
-        fOutputEvent = t->GetOutputEvent();
-        // copy address of analysis tree of the given thread
-        // to the local tree, then fill the local tree
-        TObjArray* branchesT;
-        TObjArray* branchesL;
-
-        if (fAnalysisTree != nullptr) {
-            TRestAnalysisTree* remotetree = t->GetAnalysisTree();
-
-            // t->GetAnalysisTree()->SetEventInfo(t->GetOutputEvent());
-            // branchesT = t->GetAnalysisTree()->GetListOfBranches();
-            // branchesL = fAnalysisTree->GetListOfBranches();
-            // for (int i = 0; i < nBranches; i++) {
-            //    TBranch* branchT = (TBranch*)branchesT->UncheckedAt(i);
-            //    TBranch* branchL = (TBranch*)branchesL->UncheckedAt(i);
-            //    branchL->SetAddress(branchT->GetAddress());
-            //}
-            fAnalysisTree->SetEventInfo(fOutputEvent);
-            for (int n = 0; n < remotetree->GetNumberOfObservables(); n++) {
+    fPendingOutput[entry] = slot;
+    // the previous entries might have been written while copying
+    bool written = entry == fNextOutputEntry;
+    WritePendingOutput();
+    lock.unlock();
+    if (written) outputWritten.notify_all();
+}
+
+///////////////////////////////////////////////
+/// \brief Writes the entries waiting in the reorder buffer, as long as they are
+/// consecutive to the last entry written.
+///
+/// The caller must hold the write lock.
+void TRestProcessRunner::WritePendingOutput() {
+    auto iter = fPendingOutput.begin();
+    while (iter != fPendingOutput.end() && iter->first == fNextOutputEntry) {
+        if (iter->second != nullptr) {
+            WriteOutputSlot(iter->second);
+            fFreeOutputSlots.push_back(iter->second);
+        }
+        fNextOutputEntry++;
+        iter = fPendingOutput.erase(iter);
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Copies the output event and observables of the given thread to the
+/// output trees, and fills them.
+///
+/// The caller must hold the write lock.
+void TRestProcessRunner::WriteThreadEvent(TRestThread* t) {
+    if (t->GetOutputEvent() == nullptr) return;
+
+    fOutputEvent = t->GetOutputEvent();
+    // copy address of analysis tree of the given thread
+    // to the local tree, then fill the local tree
+    if (fAnalysisTree != nullptr) {
+        TRestAnalysisTree* remotetree = t->GetAnalysisTree();
+
+        fAnalysisTree->SetEventInfo(fOutputEvent);
+
+        // Until the output tree has all the observables we add them one by one. Then the copy
+        // plan is built once.
+        Int_t nObservables = remotetree->GetNumberOfObservables();
+        ObservableCopyPlan& plan = fThreadCopyPlans[t->GetThreadId()];
+        if (plan.nObservables != nObservables && fAnalysisTree->GetNumberOfObservables() == nObservables) {
+            plan.Build(GetObservableList(remotetree), GetObservableList(fAnalysisTree));
+        }
+
+        if (plan.nObservables == nObservables) {
+            plan.Copy();
+        } else {
+            for (int n = 0; n < nObservables; n++) {
                 fAnalysisTree->SetObservable(n, remotetree->GetObservable(n));
             }
+        }
+    }
+
+    const auto& events = fThreadEventObjects[t->GetThreadId()];
+    for (unsigned int i = 0; i < fEventTreeObjects.size() && i < events.size(); i++) {
+        fEventTreeObjects[i] = events[i];
+    }
+
+    FillOutputTrees();
+}
+
+///////////////////////////////////////////////
+/// \brief Copies an event waiting in the reorder buffer to the output trees,
+/// and fills them.
+///
+/// The caller must hold the write lock.
+void TRestProcessRunner::WriteOutputSlot(OutputSlot* slot) {
+    if (fAnalysisTree != nullptr) {
+        fAnalysisTree->SetEventInfo(slot->runOrigin, slot->subRunOrigin, slot->eventID, slot->subEventID,
+                                    slot->timeStamp, slot->subEventTag);
 
-            fAnalysisTree->Fill();
+        Int_t nObservables = slot->observables.size();
+        ObservableCopyPlan& plan = slot->toOutput;
+        if (plan.nObservables != nObservables && fAnalysisTree->GetNumberOfObservables() == nObservables) {
+            plan.Build(slot->observables, GetObservableList(fAnalysisTree));
         }
 
-        if (fEventTree != nullptr) {
-            // t->GetEventTree()->FillEvent(t->GetOutputEvent());
-            branchesT = t->GetEventTree()->GetListOfBranches();
-            branchesL = fEventTree->GetListOfBranches();
-            for (int i = 0; i < branchesT->GetLast() + 1; i++) {
-                TBranch* branchT = (TBranch*)branchesT->UncheckedAt(i);
-                TBranch* branchL = (TBranch*)branchesL->UncheckedAt(i);
-                branchL->SetAddress(branchT->GetAddress());
+        if (plan.nObservables == nObservables) {
+            plan.Copy();
+        } else {
+            for (int n = 0; n < nObservables; n++) {
+                fAnalysisTree->SetObservable(n, slot->observables[n]);
             }
-            fEventTree->Fill();
         }
-        fProcessedEvents++;
-
-        // cout << fTempOutputDataFile << " " << fTempOutputDataFile->GetEND() << " " <<
-        // fAnalysisTree->GetDirectory() << endl; cout << fAutoSplitFileSize << endl; switch file if file size
-        // reaches target
-        if (fOutputDataFile->GetEND() > fFileSplitSize) {
-            if (fAnalysisTree->GetDirectory() == (TDirectory*)fOutputDataFile) {
-                fNFilesSplit++;
-                cout << "TRestProcessRunner: file size reaches limit (" << fFileSplitSize
-                     << " bytes), switching to new file with index " << fNFilesSplit << endl;
-
-                // wait 0.1s for the process to finish
-                usleep(100000);
-                for (auto th : fThreads) {
-                    for (int j = 0; j < fProcessNumber; j++) {
-                        auto proc = th->GetProcess(j);
-                        proc->NotifyAnalysisTreeReset();
-                    }
-                }
+    }
 
-                fAnalysisTree->AutoSave();
-                fAnalysisTree->Reset();
+    for (unsigned int i = 0; i < fEventTreeObjects.size() && i < slot->events.size(); i++) {
+        fEventTreeObjects[i] = slot->events[i];
+    }
 
-                if (fEventTree != nullptr) {
-                    fEventTree->AutoSave();
-                    fEventTree->Reset();
-                }
+    FillOutputTrees();
+}
 
-                // write some information to the first(main) data file
-                fRunInfo->SetNFilesSplit(fNFilesSplit);
-                if (fOutputDataFile->GetName() != fOutputDataFileName) {
-                    auto Mainfile = std::unique_ptr<TFile>{TFile::Open(fOutputDataFileName, "update")};
-                    WriteProcessesMetadata();
-                    Mainfile->Write(0, TObject::kOverwrite);
-                    Mainfile->Close();
-                } else {
-                    WriteProcessesMetadata();
+///////////////////////////////////////////////
+/// \brief Fills the output trees, and switches to a new file if the size of
+/// the output file reaches the limit.
+///
+/// The caller must hold the write lock.
+void TRestProcessRunner::FillOutputTrees() {
+#ifdef TIME_MEASUREMENT
+    high_resolution_clock::time_point t5 = high_resolution_clock::now();
+#endif
+    if (fAnalysisTree != nullptr) {
+        fAnalysisTree->Fill();
+    }
+    if (fEventTree != nullptr) {
+        fEventTree->Fill();
+    }
+    fProcessedEvents++;
+    if (fProcessedEvents == fEventsToProcess) {
+        runnerStatusChanged.notify_all();
+    }
+
+    // cout << fTempOutputDataFile << " " << fTempOutputDataFile->GetEND() << " " <<
+    // fAnalysisTree->GetDirectory() << endl; cout << fAutoSplitFileSize << endl; switch file if file size
+    // reaches target
+    if (fOutputDataFile->GetEND() > fFileSplitSize) {
+        if (fAnalysisTree->GetDirectory() == (TDirectory*)fOutputDataFile) {
+            fNFilesSplit++;
+            cout << "TRestProcessRunner: file size reaches limit (" << fFileSplitSize
+                 << " bytes), switching to new file with index " << fNFilesSplit << endl;
+
+            for (auto th : fThreads) {
+                for (int j = 0; j < fProcessNumber; j++) {
+                    auto proc = th->GetProcess(j);
+                    proc->NotifyAnalysisTreeReset();
                 }
+            }
+
+            // the tree headers must reach the old file before the branches are redirected
+            fAnalysisTree->AutoSave();
+            fAnalysisTree->Reset();
+
+            if (fEventTree != nullptr) {
+                fEventTree->AutoSave();
+                fEventTree->Reset();
+            }
 
-                TFile* newfile = new TFile(fOutputDataFileName + "." + ToString(fNFilesSplit), "recreate");
+            fRunInfo->SetNFilesSplit(fNFilesSplit);
+
+            // the metadata is streamed here, under the write lock that guards fProcessedEvents,
+            // so that the background writer never reads the runner or its processes
+            WriteProcessesMetadata(fOutputDataFile);
+
+            TFile* newfile = new TFile(fOutputDataFileName + "." + ToString(fNFilesSplit), "recreate");
+
+            TBranch* branch = nullptr;
+            fAnalysisTree->SetDirectory(newfile);
+            TIter nextb1(fAnalysisTree->GetListOfBranches());
+            while ((branch = (TBranch*)nextb1())) {
+                branch->SetFile(newfile);
+            }
+            if (fAnalysisTree->GetBranchRef()) {
+                fAnalysisTree->GetBranchRef()->SetFile(newfile);
+            }
 
-                TBranch* branch = nullptr;
-                fAnalysisTree->SetDirectory(newfile);
-                TIter nextb1(fAnalysisTree->GetListOfBranches());
-                while ((branch = (TBranch*)nextb1())) {
+            if (fEventTree != nullptr) {
+                fEventTree->SetDirectory(newfile);
+                TIter nextb2(fEventTree->GetListOfBranches());
+                while ((branch = (TBranch*)nextb2())) {
                     branch->SetFile(newfile);
                 }
-                if (fAnalysisTree->GetBranchRef()) {
-                    fAnalysisTree->GetBranchRef()->SetFile(newfile);
+                if (fEventTree->GetBranchRef()) {
+                    fEventTree->GetBranchRef()->SetFile(newfile);
                 }
-
-                if (fEventTree != nullptr) {
-                    fEventTree->SetDirectory(newfile);
-                    TIter nextb2(fEventTree->GetListOfBranches());
-                    while ((branch = (TBranch*)nextb2())) {
-                        branch->SetFile(newfile);
-                    }
-                    if (fEventTree->GetBranchRef()) {
-                        fEventTree->GetBranchRef()->SetFile(newfile);
-                    }
-                }
-
-                fOutputDataFile->Write(nullptr, TObject::kOverwrite);
-                fOutputDataFile->Close();
-                delete fOutputDataFile;
-                fOutputDataFile = newfile;
-            } else {
-                RESTError << "internal error!" << RESTendl;
             }
+
+            // the old file no longer holds anything the threads write to, it is closed in the
+            // background. ROOT thread safety was enabled by RunProcess()
+            fSplitFileWriters.emplace_back(&TRestProcessRunner::CloseSplitFile, fOutputDataFile);
+            fOutputDataFile = newfile;
+        } else {
+            RESTError << "internal error!" << RESTendl;
         }
+    }
 
 #ifdef TIME_MEASUREMENT
-        high_resolution_clock::time_point t6 = high_resolution_clock::now();
-        writeTime += (int)duration_cast<microseconds>(t6 - t5).count();
+    high_resolution_clock::time_point t6 = high_resolution_clock::now();
+    writeTime += (int)duration_cast<microseconds>(t6 - t5).count();
 #endif
 
-        if (fProcStatus == kStep) {
-            fProcStatus = kPause;
-            cout << "Processed events:" << fProcessedEvents << endl;
-        }
+    if (fProcStatus == kStep) {
+        fProcStatus = kPause;
+        runnerStatusChanged.notify_all();
+        cout << "Processed events:" << fProcessedEvents << endl;
     }
-    mutex_write.unlock();
 }
 
 ///////////////////////////////////////////////
@@ -984,10 +1333,12 @@ void TRestProcessRunner::ConfigOutputFile() {
 }
 
 ///////////////////////////////////////////////
-/// \brief Write process metadata to fOutputDataFile
+/// \brief Writes the runner and the process metadata to the given file.
+/// If no file is given, fOutputDataFile is used.
 ///
-void TRestProcessRunner::WriteProcessesMetadata() {
-    fOutputDataFile->cd();
+void TRestProcessRunner::WriteProcessesMetadata(TFile* file) {
+    if (file == nullptr) file = fOutputDataFile;
+    file->cd();
 
     this->Write(nullptr, TObject::kWriteDelete);
 
@@ -999,6 +1350,29 @@ void TRestProcessRunner::WriteProcessesMetadata() {
     }
 }
 
+///////////////////////////////////////////////
+/// \brief Completes a file the output trees were split away from: flushes the
+/// remaining keys and closes it.
+///
+/// It runs on its own thread, while the processing threads keep filling the
+/// trees in the next file. The metadata has already been written to the file
+/// by FillOutputTrees(), so that it only touches objects owned by the file.
+void TRestProcessRunner::CloseSplitFile(TFile* file) {
+    file->Write(nullptr, TObject::kOverwrite);
+    file->Close();
+    delete file;
+}
+
+///////////////////////////////////////////////
+/// \brief Waits until all the split files are written and closed
+///
+void TRestProcessRunner::JoinSplitFileWriters() {
+    for (auto& writer : fSplitFileWriters) {
+        writer.join();
+    }
+    fSplitFileWriters.clear();
+}
+
 ///////////////////////////////////////////////
 /// \brief Calls TRestRun::MergeOutputFile() to merge the main file with process's tmp file.
 ///
@@ -1167,6 +1541,27 @@ string TRestProcessRunner::MakeProgressBar(int progress100, int length) {
     return progressbar;
 }
 
+///////////////////////////////////////////////
+/// \brief It returns the lowest position in the reading sequence of the events
+/// that are still being processed by any of the threads.
+///
+/// All the events read before this entry have already gone through the whole
+/// process chain. It allows processes to reconstruct the global order of the
+/// event stream under multi-thread mode, see TRestEventRateAnalysisProcess.
+///
+/// It does not lock: an entry is assigned to its thread before the read counter
+/// includes it, and TRestEventProcess::NotifyEntryFinished() is called once the
+/// thread has released it, so that a process can wait for the result to change.
+///
+Long64_t TRestProcessRunner::GetFirstUnfinishedEntry() const {
+    Long64_t first = inputEntriesRead;
+    for (const auto& t : fThreads) {
+        Long64_t entry = t->GetInputEntry();
+        if (entry >= 0 && entry < first) first = entry;
+    }
+    return first;
+}
+
 TRestEvent* TRestProcessRunner::GetInputEvent() { return fRunInfo->GetInputEvent(); }
 
 TRestAnalysisTree* TRestProcessRunner::GetInputAnalysisTree() { return fRunInfo->GetAnalysisTree(); }
@@ -1189,6 +1584,7 @@ void TRestProcessRunner::PrintMetadata() {
     RESTMetadata << "Processes in each thread : " << fProcessNumber << RESTendl;
     RESTMetadata << "File auto split size: " << fFileSplitSize << RESTendl;
     RESTMetadata << "File compression level: " << fFileCompression << RESTendl;
+    RESTMetadata << "Parallel compression: " << (fParallelCompression ? "ON" : "OFF") << RESTendl;
     RESTMetadata << "******************************************" << RESTendl;
     RESTMetadata << RESTendl;
     RESTMetadata << RESTendl;
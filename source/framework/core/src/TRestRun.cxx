@@ -6,6 +6,18 @@
 /// raw data file(opened with external process) or root file(opened with built-
 /// in reader). TRestRun extracts event data in the input file and wraps it
 /// into TRestEvent class, which is queried by other classes.
+///
+/// When the input file name pattern matches several REST files, only the
+/// first one is read by default. With the parameter `chainInputFiles` set to
+/// true, the trees of all of them are read as a single input, see
+/// TRestRun::ChainInputFiles().
+///
+/// \code
+/// <TRestRun name="Run">
+///     <parameter name="inputFileName" value="R01*_Analysis.root"/>
+///     <parameter name="chainInputFiles" value="true"/>
+/// </TRestRun>
+/// \endcode
 //
 /// \class TRestRun
 ///
@@ -22,6 +34,10 @@
 /// 2017-Aug:  Major change: added for multi-thread capability
 ///            Kaixiang Ni
 ///
+/// 2026-October: Several input files can be read as a single input
+///
+/// 2026-October: Added TRestRun::MergeFiles, merging REST files with their metadata
+///
 /// <hr>
 //////////////////////////////////////////////////////////////////////////
 
@@ -36,7 +52,13 @@
 #include <unistd.h>
 #endif  // !WIN32
 
+#include <TLeaf.h>
+#include <TROOT.h>
+
+#include <algorithm>
 #include <filesystem>
+#include <set>
+#include <thread>
 
 #include "TRestDataBase.h"
 #include "TRestEventProcess.h"
@@ -299,7 +321,11 @@ void TRestRun::InitFromConfigFile() {
 
     // 5. Open input file(s). We open input file at the last stage in case the file name pattern
     // reading requires TRestDetector
+    fChainInputFiles = StringToBool(GetParameter("chainInputFiles", "false"));
     OpenInputFile(0);
+    if (fChainInputFiles) {
+        ChainInputFiles();
+    }
     RESTDebug << "TRestRun::EndOfInit. InputFile pattern: \"" << fInputFileName << "\"" << RESTendl;
     RESTInfo << "which matches :" << RESTendl;
     for (const auto& inputFileName : fInputFileNames) {
@@ -642,6 +668,211 @@ void TRestRun::ReadInputFileTrees() {
     }
 }
 
+namespace {
+/// The name and type of each branch of a tree. Trees with different lists cannot be merged or chained
+vector<string> GetBranchTypes(TTree* tree) {
+    vector<string> types;
+    if (tree == nullptr) return types;
+    TIter nextBranch(tree->GetListOfBranches());
+    while (auto branch = (TBranch*)nextBranch()) {
+        string type = branch->GetClassName();
+        if (type.empty() && branch->GetListOfLeaves()->GetEntriesFast() > 0) {
+            type = ((TLeaf*)branch->GetListOfLeaves()->At(0))->GetTypeName();
+        }
+        types.push_back((string)branch->GetName() + ":" + type);
+    }
+    return types;
+}
+}  // namespace
+
+///////////////////////////////////////////////
+/// \brief Appends the trees of the rest of the files in the input file list to
+/// the trees of the input file already opened, so that all of them are read as
+/// a single input.
+///
+/// The process chain is then initialized once for all the files, and the
+/// threads of TRestProcessRunner do not stop at the file boundaries. The split
+/// files of each input file are chained as well. The files must contain the
+/// same observables and event branch, the files which do not are skipped.
+///
+/// The run metadata is the one of the first file, with the start and end times
+/// extended to cover all the chained files. The run number and the entry range
+/// of each file are kept, see TRestRun::GetInputFileEntryRange(). The run number
+/// is given as run origin to the events of the file which have none, see
+/// TRestRun::GetInputRunNumber().
+void TRestRun::ChainInputFiles() {
+    fInputFileFirstEntries.clear();
+    fInputFileEntries.clear();
+    fInputFileRunNumbers.clear();
+    if (fInputFile == nullptr || fAnalysisTree == nullptr || fInputFileNames.size() < 2) {
+        return;
+    }
+
+    RESTEssential << "Chaining the trees of " << fInputFileNames.size() << " input files" << RESTendl;
+
+    TChain* eventChain = nullptr;
+    if (fEventTree != nullptr && fInputEvent != nullptr) {
+        eventChain = dynamic_cast<TChain*>(fEventTree);
+        if (eventChain == nullptr) {
+            delete fEventTree;
+            eventChain = new TChain("EventTree");
+            eventChain->Add(fInputFile->GetName());
+            string brname = (string)fInputEvent->ClassName() + "Branch";
+            eventChain->SetBranchAddress(brname.c_str(), &fInputEvent);
+            fEventTree = eventChain;
+        }
+    }
+
+    // the trees of the other files must have the same branches as the ones of the first file
+    const vector<string> analysisBranches = GetBranchTypes(fInputFile->Get<TTree>("AnalysisTree"));
+    const vector<string> eventBranches = GetBranchTypes(fInputFile->Get<TTree>("EventTree"));
+
+    // the number of trees in the chain of each input file, to find their first entry later
+    vector<Int_t> chainedTrees = {fNFilesSplit + 1};
+    vector<Int_t> runNumbers = {fRunNumber};
+    for (const auto& inputFileName : fInputFileNames) {
+        string fileName = (string)inputFileName;
+        if (fileName == fInputFile->GetName() || !TRestTools::isRootFile(fileName)) {
+            continue;
+        }
+
+        // the run number and the number of split files are stored in the TRestRun of the file
+        TFile* file = TFile::Open(fileName.c_str());
+        if (file == nullptr || file->IsZombie()) {
+            RESTWarning << "TRestRun::ChainInputFiles. Cannot open file " << fileName << ", skipping"
+                        << RESTendl;
+            delete file;
+            continue;
+        }
+        TRestRun* run = (TRestRun*)GetMetadataClass("TRestRun", file);
+        if (run == nullptr) {
+            RESTWarning << "TRestRun::ChainInputFiles. " << fileName
+                        << " is not a REST file, skipping" << RESTendl;
+            file->Close();
+            delete file;
+            continue;
+        }
+        Int_t runNumber = run->GetRunNumber();
+        Int_t nFilesSplit = run->fNFilesSplit;
+        Double_t startTime = run->fStartTime;
+        Double_t endTime = run->fEndTime;
+        delete run;
+        file->Close();
+        delete file;
+
+        Int_t nTrees = 0;
+        for (int i = 0; i <= nFilesSplit; i++) {
+            string treeFileName = i == 0 ? fileName : fileName + "." + ToString(i);
+
+            // the trees are checked with the file open read-only. They are then added to both chains
+            // with their known entries, so that the chains do not open the file again and cannot
+            // fail after one of them has taken it
+            string problem;
+            TFile* treeFile = TFile::Open(treeFileName.c_str());
+            TTree* analysisTree = treeFile == nullptr ? nullptr : treeFile->Get<TTree>("AnalysisTree");
+            TTree* eventTree = treeFile == nullptr ? nullptr : treeFile->Get<TTree>("EventTree");
+            if (treeFile == nullptr || treeFile->IsZombie()) {
+                problem = "cannot be opened";
+            } else if (analysisTree == nullptr || GetBranchTypes(analysisTree) != analysisBranches) {
+                problem = "has different observables";
+            } else if (eventChain != nullptr &&
+                       (eventTree == nullptr || GetBranchTypes(eventTree) != eventBranches)) {
+                problem = "has a different event branch";
+            } else if (treeFileName.find_first_of("*?[") != string::npos) {
+                // TChain::Add would expand the name as a wildcard
+                problem = "cannot be chained";
+            } else {
+                fAnalysisTree->AppendChainFile(treeFileName, analysisTree->GetEntries());
+                if (eventChain != nullptr) eventChain->Add(treeFileName.c_str(), eventTree->GetEntries());
+            }
+            delete treeFile;
+
+            RESTInfo << treeFileName << " --> " << (problem.empty() ? "success" : "failed") << RESTendl;
+            if (!problem.empty()) {
+                RESTWarning << "TRestRun::ChainInputFiles. " << treeFileName << " " << problem
+                            << ", skipping" << RESTendl;
+                break;
+            }
+            nTrees++;
+
+            std::error_code error;
+            auto size = std::filesystem::file_size(treeFileName, error);
+            if (!error) fTotalBytes += size;
+        }
+        if (nTrees <= nFilesSplit) {
+            RESTError << "Error adding the trees of " << fileName << ", files missing?" << RESTendl;
+            RESTError << "Your data could be incomplete!" << RESTendl;
+        }
+        if (nTrees > 0) {
+            chainedTrees.push_back(nTrees);
+            runNumbers.push_back(runNumber);
+            // the run covers the time of all the chained files
+            if (startTime > 0 && (fStartTime <= 0 || startTime < fStartTime)) fStartTime = startTime;
+            if (endTime > fEndTime) fEndTime = endTime;
+        }
+    }
+
+    TChain* chain = fAnalysisTree->GetChain();
+    if (chain == nullptr) {
+        return;
+    }
+    // initializes the total entry number and the offsets of the trees
+    fAnalysisTree->GetEntries();
+    const Long64_t* offsets = chain->GetTreeOffset();
+    Int_t firstTree = 0;
+    for (size_t i = 0; i < chainedTrees.size(); i++) {
+        fInputFileFirstEntries.push_back(offsets[firstTree]);
+        fInputFileEntries.push_back(offsets[firstTree + chainedTrees[i]] - offsets[firstTree]);
+        fInputFileRunNumbers.push_back(runNumbers[i]);
+        firstTree += chainedTrees[i];
+    }
+    fAnalysisTree->GetEntry(0);
+
+    RESTEssential << "(" << chainedTrees.size() << " input files chained, " << fAnalysisTree->GetEntries()
+                  << " entries)" << RESTendl;
+}
+
+///////////////////////////////////////////////
+/// \brief Returns the run number of the input file holding the given entry.
+///
+/// It is the run number of the run itself, unless several input files are
+/// chained. See TRestRun::ChainInputFiles().
+Int_t TRestRun::GetInputRunNumber(Long64_t entry) const {
+    if (fInputFileFirstEntries.empty()) {
+        return fRunNumber;
+    }
+    return fInputFileRunNumbers[GetInputFileIndex(entry)];
+}
+
+///////////////////////////////////////////////
+/// \brief Returns the index of the chained input file holding the given entry.
+///
+/// It is 0, the first file, unless several input files are chained. See
+/// TRestRun::ChainInputFiles().
+Int_t TRestRun::GetInputFileIndex(Long64_t entry) const {
+    auto file = std::upper_bound(fInputFileFirstEntries.begin(), fInputFileFirstEntries.end(), entry);
+    if (file == fInputFileFirstEntries.begin()) {
+        return 0;
+    }
+    return file - fInputFileFirstEntries.begin() - 1;
+}
+
+///////////////////////////////////////////////
+/// \brief Returns the first input entry of the n-th chained input file, and the
+/// entry after its last one.
+///
+/// Without chained input files, the only range is the one of all the entries.
+/// See TRestRun::ChainInputFiles().
+std::pair<Long64_t, Long64_t> TRestRun::GetInputFileEntryRange(Int_t n) const {
+    if (fInputFileFirstEntries.empty()) {
+        return {0, n == 0 ? GetEntries() : 0};
+    }
+    if (n < 0 || n >= (Int_t)fInputFileFirstEntries.size()) {
+        return {0, 0};
+    }
+    return {fInputFileFirstEntries[n], fInputFileFirstEntries[n] + fInputFileEntries[n]};
+}
+
 ///////////////////////////////////////////////
 /// \brief Extract file info from a file, and save it in the file info list
 ///
@@ -877,7 +1108,7 @@ Int_t TRestRun::GetNextEvent(TRestEvent* targetEvent, TRestAnalysisTree* targetT
     }
 
     if (fInputEvent->GetRunOrigin() == 0) {
-        fInputEvent->SetRunOrigin(fRunNumber);
+        fInputEvent->SetRunOrigin(GetInputRunNumber(fCurrentEvent - 1));
     }
 
     targetEvent->Initialize();
@@ -1030,6 +1261,213 @@ TFile* TRestRun::MergeToOutputFile(vector<string> filenames, string outputfilena
     return fOutputFile;
 }
 
+namespace {
+/// The TRestRun stored in the file, or nullptr if there is none
+TRestRun* ReadRun(TFile* file) {
+    TIter nextKey(file->GetListOfKeys());
+    while (auto key = (TKey*)nextKey()) {
+        TClass* cl = TClass::GetClass(key->GetClassName());
+        if (cl != nullptr && cl->InheritsFrom(TRestRun::Class())) {
+            return file->Get<TRestRun>(key->GetName());
+        }
+    }
+    return nullptr;
+}
+}  // namespace
+
+///////////////////////////////////////////////
+/// \brief Merges a list of REST files into a new file.
+///
+/// The trees and the rest of mergeable objects are merged by TFileMerger. The
+/// output file takes the compression settings of the first input file, so that
+/// the baskets of the inputs sharing them are copied without being decompressed
+/// and compressed again. The split files of the inputs are merged as well.
+/// The merge fails, without writing the output, if an input or one of its split
+/// files cannot be read, or if its analysis tree or event tree have different
+/// branches than the ones of the first file. Their entries could not be merged
+/// into the same trees.
+///
+/// The metadata objects, which cannot be merged, are written once, taken from
+/// the first file. Its TRestRun gets the earliest start time and the latest end
+/// time of the inputs, and the total number of entries.
+///
+/// With more than one thread, the inputs are merged in consecutive groups in
+/// parallel, and the groups are then merged together. The order of the entries
+/// is kept.
+///
+/// It returns true if the merge succeeds.
+Bool_t TRestRun::MergeFiles(const vector<string>& files, const string& outputFileName, Int_t nThreads) {
+    if (files.empty()) {
+        RESTError << "TRestRun::MergeFiles. No input files given" << TRestStringOutput::RESTendl;
+        return false;
+    }
+
+    TFile* firstFile = TFile::Open(files[0].c_str());
+    if (firstFile == nullptr || firstFile->IsZombie()) {
+        RESTError << "TRestRun::MergeFiles. Cannot open " << files[0] << TRestStringOutput::RESTendl;
+        delete firstFile;
+        return false;
+    }
+    const Int_t compression = firstFile->GetCompressionSettings();
+    const vector<string> analysisBranches = GetBranchTypes(firstFile->Get<TTree>("AnalysisTree"));
+    const vector<string> eventBranches = GetBranchTypes(firstFile->Get<TTree>("EventTree"));
+
+    // 1. The objects to be written once, from the first file
+    vector<pair<string, TObject*>> metadata;
+    string metadataNames;
+    TRestRun* run = nullptr;
+    set<string> keyNames;
+    TIter nextKey(firstFile->GetListOfKeys());
+    while (auto key = (TKey*)nextKey()) {
+        TClass* cl = TClass::GetClass(key->GetClassName());
+        if (cl == nullptr || !(cl->InheritsFrom(TRestMetadata::Class()) || cl->InheritsFrom("TGeoManager"))) {
+            continue;
+        }
+        // the keys of all the cycles are listed, the object is read from the last one
+        if (!keyNames.insert(key->GetName()).second) continue;
+        TObject* obj = firstFile->Get(key->GetName());
+        if (obj == nullptr) continue;
+        if (run == nullptr && obj->InheritsFrom(TRestRun::Class())) run = (TRestRun*)obj;
+        metadata.emplace_back(key->GetName(), obj);
+        metadataNames += (string)key->GetName() + " ";
+    }
+
+    // 2. Check the inputs and combine the run information
+    vector<string> treeFiles;
+    Double_t startTime = run != nullptr ? run->fStartTime : 0;
+    Double_t endTime = run != nullptr ? run->fEndTime : 0;
+    Long64_t entries = 0;
+    Bool_t inputsValid = true;
+    for (size_t n = 0; n < files.size() && inputsValid; n++) {
+        const string& fileName = files[n];
+        TFile* file = n == 0 ? firstFile : TFile::Open(fileName.c_str());
+        if (file == nullptr || file->IsZombie()) {
+            RESTError << "TRestRun::MergeFiles. Cannot open " << fileName << TRestStringOutput::RESTendl;
+            delete file;
+            inputsValid = false;
+            break;
+        }
+
+        TTree* analysisTree = file->Get<TTree>("AnalysisTree");
+        if (GetBranchTypes(analysisTree) != analysisBranches ||
+            GetBranchTypes(file->Get<TTree>("EventTree")) != eventBranches) {
+            RESTError << "TRestRun::MergeFiles. " << fileName << " has different observables or events than "
+                      << files[0] << TRestStringOutput::RESTendl;
+            inputsValid = false;
+        } else {
+            treeFiles.push_back(fileName);
+            if (analysisTree != nullptr) entries += analysisTree->GetEntries();
+
+            TRestRun* fileRun = ReadRun(file);
+            if (fileRun != nullptr) {
+                for (int i = 1; i <= fileRun->fNFilesSplit && inputsValid; i++) {
+                    string splitFileName = fileName + "." + ToString(i);
+                    TFile* splitFile = TFile::Open(splitFileName.c_str());
+                    if (splitFile == nullptr || splitFile->IsZombie()) {
+                        RESTError << "TRestRun::MergeFiles. Cannot open the split file " << splitFileName
+                                  << TRestStringOutput::RESTendl;
+                        inputsValid = false;
+                    } else if (GetBranchTypes(splitFile->Get<TTree>("AnalysisTree")) != analysisBranches ||
+                               GetBranchTypes(splitFile->Get<TTree>("EventTree")) != eventBranches) {
+                        RESTError << "TRestRun::MergeFiles. " << splitFileName
+                                  << " has different observables or events than " << files[0]
+                                  << TRestStringOutput::RESTendl;
+                        inputsValid = false;
+                    } else {
+                        treeFiles.push_back(splitFileName);
+                        if (splitFile->Get<TTree>("AnalysisTree") != nullptr) {
+                            entries += splitFile->Get<TTree>("AnalysisTree")->GetEntries();
+                        }
+                    }
+                    delete splitFile;
+                }
+                if (fileRun->fStartTime > 0 && (startTime <= 0 || fileRun->fStartTime < startTime)) {
+                    startTime = fileRun->fStartTime;
+                }
+                if (fileRun->fEndTime > endTime) endTime = fileRun->fEndTime;
+                delete fileRun;
+            }
+        }
+
+        if (file != firstFile) {
+            file->Close();
+            delete file;
+        }
+    }
+
+    // 3. Merge the trees
+    auto mergeFiles = [&](const vector<string>& inputs, const string& output) -> Bool_t {
+        TFileMerger merger(false);
+        merger.SetPrintLevel(0);
+        if (!merger.OutputFile(output.c_str(), "RECREATE", compression)) return false;
+        for (const auto& input : inputs) {
+            if (!merger.AddFile(input.c_str(), false)) return false;
+        }
+        merger.AddObjectNames(metadataNames.c_str());
+        return merger.PartialMerge(TFileMerger::kAll | TFileMerger::kRegular | TFileMerger::kSkipListed);
+    };
+
+    Bool_t merged = inputsValid && !treeFiles.empty();
+    nThreads = std::max(1, std::min(nThreads, (Int_t)treeFiles.size() / 2));
+    if (merged) {
+        RESTInfo << "TRestRun::MergeFiles. Merging " << treeFiles.size() << " files into " << outputFileName
+                 << " with " << nThreads << " thread(s)" << TRestStringOutput::RESTendl;
+    }
+    if (merged && nThreads > 1) {
+        ROOT::EnableThreadSafety();
+        vector<string> groupFiles(nThreads);
+        vector<char> groupMerged(nThreads, false);
+        vector<thread> threads;
+        for (int i = 0; i < nThreads; i++) {
+            vector<string> group(treeFiles.begin() + i * treeFiles.size() / nThreads,
+                                 treeFiles.begin() + (i + 1) * treeFiles.size() / nThreads);
+            groupFiles[i] = outputFileName + ".part" + ToString(i);
+            threads.emplace_back([&, i, group] { groupMerged[i] = mergeFiles(group, groupFiles[i]); });
+        }
+        for (auto& t : threads) t.join();
+
+        merged = std::all_of(groupMerged.begin(), groupMerged.end(), [](char ok) { return ok; }) &&
+                 mergeFiles(groupFiles, outputFileName);
+        for (const auto& groupFile : groupFiles) remove(groupFile.c_str());
+    } else if (merged) {
+        merged = mergeFiles(treeFiles, outputFileName);
+    }
+
+    // 4. Write the metadata
+    if (merged) {
+        if (run != nullptr) {
+            run->fStartTime = startTime;
+            run->fEndTime = endTime;
+            run->fEntriesSaved = entries;
+            run->fNFilesSplit = 0;
+        }
+        TFile* output = TFile::Open(outputFileName.c_str(), "UPDATE");
+        if (output != nullptr && !output->IsZombie()) {
+            // TRestMetadata::Write() would replace the stored configuration with an empty one
+            for (const auto& meta : metadata) {
+                output->WriteTObject(meta.second, meta.first.c_str(), "Overwrite");
+            }
+            output->Close();
+        } else {
+            RESTError << "TRestRun::MergeFiles. Cannot write the metadata to " << outputFileName
+                      << TRestStringOutput::RESTendl;
+            merged = false;
+        }
+        delete output;
+    } else {
+        RESTError << "TRestRun::MergeFiles. Failed to merge the files into " << outputFileName
+                  << TRestStringOutput::RESTendl;
+    }
+
+    for (const auto& meta : metadata) {
+        // a geometry read from a file becomes gGeoManager, it is kept
+        if (!meta.second->InheritsFrom("TGeoManager")) delete meta.second;
+    }
+    firstFile->Close();
+    delete firstFile;
+    return merged;
+}
+
 ///////////////////////////////////////////////
 /// \brief Create a new TFile as REST output file. Writing metadata objects into it.
 ///
@@ -1154,6 +1592,8 @@ void TRestRun::WriteWithDataBase() {
 ///
 void TRestRun::CloseFile() {
     fEntriesSaved = -1;
+    fInputFileFirstEntries.clear();
+    fInputFileRunNumbers.clear();
     if (fAnalysisTree != nullptr) {
         fEntriesSaved = fAnalysisTree->GetEntries();
         if (fAnalysisTree->GetEntries() > 0 && fInputFile == nullptr) {
@@ -1377,10 +1817,8 @@ TRestEvent* TRestRun::GetEventWithID(Int_t eventID, Int_t subEventID, const TStr
         int nEntries = fAnalysisTree->GetEntries();
 
         // set analysis tree to read only three branches
-        fAnalysisTree->SetBranchStatus("*", false);
-        fAnalysisTree->SetBranchStatus("eventID", true);
-        fAnalysisTree->SetBranchStatus("subEventID", true);
-        fAnalysisTree->SetBranchStatus("subEventTag", true);
+        std::vector<Bool_t> branchStatus =
+            fAnalysisTree->EnableOnlyBranches({"eventID", "subEventID", "subEventTag"});
 
         // just look through the whole analysis tree and find the entry
         // this is not good!
@@ -1390,14 +1828,14 @@ TRestEvent* TRestRun::GetEventWithID(Int_t eventID, Int_t subEventID, const TStr
                 if (subEventID != -1 && fAnalysisTree->GetSubEventID() != subEventID) continue;
                 if (tag != "" && fAnalysisTree->GetSubEventTag() != tag) continue;
                 if (fEventTree != nullptr) fEventTree->GetEntry(i);
-                fAnalysisTree->SetBranchStatus("*", true);
+                fAnalysisTree->RestoreBranchStatus(branchStatus);
                 fAnalysisTree->GetEntry(i);
                 fCurrentEvent = i;
                 return fInputEvent;
             }
         }
         // reset the branch status
-        fAnalysisTree->SetBranchStatus("*", true);
+        fAnalysisTree->RestoreBranchStatus(branchStatus);
     }
     return nullptr;
 }
@@ -1463,9 +1901,10 @@ std::vector<int> TRestRun::GetEventEntriesWithConditions(const string& cuts, int
         }
     }
     // read only the necessary branches
-    fAnalysisTree->SetBranchStatus("*", false);
+    std::vector<Bool_t> branchStatus = fAnalysisTree->EnableOnlyBranches(observables);
+    std::vector<Int_t> observableIds;
     for (unsigned int i = 0; i < observables.size(); i++) {
-        fAnalysisTree->SetBranchStatus(observables[i].c_str(), true);
+        observableIds.push_back(fAnalysisTree->GetObservableID(observables[i]));
     }
     // comparison code
     Double_t valueToCompareFrom;
@@ -1476,7 +1915,7 @@ std::vector<int> TRestRun::GetEventEntriesWithConditions(const string& cuts, int
         fAnalysisTree->GetEntry(i);
         comparisonResult = true;
         for (unsigned int j = 0; j < observables.size(); j++) {
-            valueToCompareFrom = fAnalysisTree->GetDblObservableValue(observables[j].c_str());
+            valueToCompareFrom = fAnalysisTree->GetDblObservableValue(observableIds[j]);
             if (operators[j] == "=" || operators[j] == "==") {
                 comparisonResult = comparisonResult && (valueToCompareFrom == values[j]);
             } else if (operators[j] == "<") {
@@ -1499,7 +1938,7 @@ std::vector<int> TRestRun::GetEventEntriesWithConditions(const string& cuts, int
         }
     }
     // reset branch status
-    fAnalysisTree->SetBranchStatus("*", true);
+    fAnalysisTree->RestoreBranchStatus(branchStatus);
     return eventIds;
 }
 
@@ -22,6 +22,9 @@
 
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "TRestStringHelper.h"
 
@@ -73,6 +76,8 @@ map<string, pair<int, double>> __ListOfRESTUnits;  // name, {type, scale}
 /// 2017-Aug:  Major upgrades
 ///            Kaixiang Ni
 ///
+/// 2026-October: Parsed unit definitions are cached, and their dimensions can be compared
+///
 /// \class TRestSystemOfUnits
 /// \namespace REST_Units
 /// \author     Javier Galan
@@ -90,7 +95,21 @@ namespace REST_Units {
 /// V/cm, kg-yr
 ///
 /// Note: REST doesn't support units combination with numbers, e.g. m/s^2
-bool IsUnit(string unitsStr) { return !TRestSystemOfUnits(unitsStr).IsZombie(); }
+bool IsUnit(string unitsStr) { return !TRestSystemOfUnits::Get(unitsStr)->IsZombie(); }
+
+///////////////////////////////////////////////
+/// \brief Checks if the two unit definitions describe the same physical dimension
+///
+/// e.g. "V/cm" and "kV/m" are compatible, "V/cm" and "V" are not. It returns false if one of
+/// them is not a unit. It is meant to validate the units given in a config file when it is
+/// loaded, instead of finding a wrong value later:
+///
+/// \code
+/// if (!REST_Units::AreCompatibleUnits(unit, "V/cm")) { ... }
+/// \endcode
+bool AreCompatibleUnits(string unitsA, string unitsB) {
+    return TRestSystemOfUnits::Get(unitsA)->HasSameDimension(*TRestSystemOfUnits::Get(unitsB));
+}
 
 ///////////////////////////////////////////////
 /// \brief Checks if the string is a REST basic unit
@@ -101,13 +120,19 @@ bool IsBasicUnit(string unitsStr) { return (__ListOfRESTUnits.count(unitsStr) ==
 /// \brief Get the scale to REST standard unit. scale (unitsdef) = 1 (standard unit)
 ///
 /// e.g. 0.001(m) = 1(mm). Where "mm" is REST standard unit.
-double GetScaleToStandardUnit(string unitsdef) { return 1 * TRestSystemOfUnits(unitsdef); }
+///
+/// The definition is only parsed the first time it is seen. When the units are known at compile
+/// time, the constants of this namespace give the same scale without any parsing, e.g.
+/// `REST_Units::keV / REST_Units::mm` is the scale of "keV/mm".
+double GetScaleToStandardUnit(string unitsdef) { return 1 * *TRestSystemOfUnits::Get(unitsdef); }
 
 ///////////////////////////////////////////////
 /// \brief Get standard form of this unit definition
 ///
 /// e.g. m/s --> mm/us
-string GetStandardUnitDefinition(string unitsdef) { return units(unitsdef).ToStandardDefinition(); }
+string GetStandardUnitDefinition(string unitsdef) {
+    return TRestSystemOfUnits::Get(unitsdef)->ToStandardDefinition();
+}
 
 ///////////////////////////////////////////////
 /// \brief Find and return the units definition in a string
@@ -237,14 +262,14 @@ TVector3 Get3DVectorInRESTUnits(string in) { return Get3DVectorValueInString(in)
 /// `SetExposure(a*units("ton-day"));`
 /// This explictily adds the unit "ton-day" to the "unitless" value a.
 Double_t ConvertValueToRESTUnits(Double_t value, string unitsStr) {
-    return value / TRestSystemOfUnits((string)unitsStr);
+    return value / *TRestSystemOfUnits::Get(unitsStr);
 }
 
 ///////////////////////////////////////////////
 /// \brief Convert value with REST units into the given custom units
 ///
 Double_t ConvertRESTUnitsValueToCustomUnits(Double_t value, string unitsStr) {
-    return value * TRestSystemOfUnits((string)unitsStr);
+    return value * *TRestSystemOfUnits::Get(unitsStr);
 }
 
 ///////////////////////////////////////////////
@@ -277,7 +302,36 @@ double _AddUnit(string name, int type, double scale) {
 ///
 /// \class TRestSystemOfUnits
 ///
-TRestSystemOfUnits::TRestSystemOfUnits(string unitsStr) {
+TRestSystemOfUnits::TRestSystemOfUnits(string unitsStr) { *this = *Get(unitsStr); }
+
+///////////////////////////////////////////////
+/// \brief Returns the parsed unit definition
+///
+/// Each unit string is parsed once, and the result is shared by the following calls from any
+/// thread. The cache is emptied when it gets too large, the objects already returned stay valid.
+shared_ptr<const TRestSystemOfUnits> TRestSystemOfUnits::Get(const string& unitsStr) {
+    static shared_mutex cacheMutex;
+    static unordered_map<string, shared_ptr<const TRestSystemOfUnits>> cache;
+    {
+        shared_lock<shared_mutex> lock(cacheMutex);
+        auto it = cache.find(unitsStr);
+        if (it != cache.end()) return it->second;
+    }
+
+    shared_ptr<TRestSystemOfUnits> result(new TRestSystemOfUnits());
+    result->Parse(unitsStr);
+
+    // the list of units is empty during the static initialization, when nothing must be cached
+    if (__ListOfRESTUnits.empty()) return result;
+
+    // the values of arbitrary parameters are checked for units, so the cache is bounded
+    unique_lock<shared_mutex> lock(cacheMutex);
+    if (cache.size() >= 100000) cache.clear();
+    cache.emplace(unitsStr, result);
+    return result;
+}
+
+void TRestSystemOfUnits::Parse(string unitsStr) {
     unitsStr = Trim(unitsStr);
 
     // We skip for the moment parameters/fields that contain elements {,,,}.
@@ -361,20 +415,45 @@ TRestSystemOfUnits::TRestSystemOfUnits(string unitsStr) {
 }
 
 int TRestSystemOfUnits::GetUnitType(string singleUnit) {
-    if (IsBasicUnit(singleUnit)) {
-        return __ListOfRESTUnits[singleUnit].first;
+    auto it = __ListOfRESTUnits.find(singleUnit);
+    if (it != __ListOfRESTUnits.end()) {
+        return it->second.first;
     }
     return -1;
 }
 
 double TRestSystemOfUnits::GetUnitScale(string singleUnit) {
-    if (IsBasicUnit(singleUnit)) {
-        return __ListOfRESTUnits[singleUnit].second;
+    auto it = __ListOfRESTUnits.find(singleUnit);
+    if (it != __ListOfRESTUnits.end()) {
+        return it->second.second;
     }
     return 1;
 }
 
-string TRestSystemOfUnits::ToStandardDefinition() {
+///////////////////////////////////////////////
+/// \brief Returns the order of each type of unit, e.g. {Voltage: 1, Length: -1} for "V/cm"
+///
+/// The types whose orders cancel out, as in "mm/cm", are not listed.
+map<int, double> TRestSystemOfUnits::GetDimension() const {
+    map<int, double> dimension;
+    for (unsigned int i = 0; i < fComponents.size(); i++) {
+        dimension[fComponents[i]] += fComponentOrder[i];
+    }
+    for (auto it = dimension.begin(); it != dimension.end();) {
+        it = it->second == 0 ? dimension.erase(it) : next(it);
+    }
+    return dimension;
+}
+
+///////////////////////////////////////////////
+/// \brief Whether the two units describe the same physical dimension, and can be converted one into
+/// the other
+bool TRestSystemOfUnits::HasSameDimension(const TRestSystemOfUnits& units) const {
+    if (fZombie || units.fZombie) return false;
+    return GetDimension() == units.GetDimension();
+}
+
+string TRestSystemOfUnits::ToStandardDefinition() const {
     string result = "";
     for (unsigned int i = 0; i < fComponents.size(); i++) {
         if (fComponentOrder[i] < 0) {
@@ -1,7 +1,7 @@
 
 ///
 /// Multiple instances of TRestThread is created inside TRestProcessRunner.
-/// Each of them can detach a thread containing a process chain, which
+/// Each of them can start a thread containing a process chain, which
 /// implements multi thread functionality. Preparation of process chain
 /// is also done inside this class.
 ///
@@ -25,6 +25,8 @@
 
 #include "TRestThread.h"
 
+#include <new>
+
 using namespace std;
 
 #ifdef TIME_MEASUREMENT
@@ -47,6 +49,7 @@ void TRestThread::Initialize() {
     fProcessChain.clear();
 
     isFinished = false;
+    fInputEntry = -1;
 
     fCompressionLevel = 1;
     fVerboseLevel = TRestStringOutput::REST_Verbose_Level::REST_Essential;
@@ -433,9 +436,14 @@ void TRestThread::PrepareToProcess(bool* outputConfig) {
 void TRestThread::StartProcess() {
     isFinished = false;
 
-    while (fHostRunner->GetNextevtFunc(fInputEvent, fAnalysisTree) == 0) {
+    while (fHostRunner->GetNextevtFunc(fInputEvent, fAnalysisTree, this) == 0) {
         ProcessEvent();
         /*if (fOutputEvent != nullptr) */ fHostRunner->FillThreadEventFunc(this);
+        const Long64_t entry = fInputEntry;
+        fInputEntry = -1;
+        if (entry >= 0) {
+            for (auto& p : fProcessChain) p->NotifyEntryFinished(entry);
+        }
     }
 
     // fHostRunner->WriteThreadFileFunc(this);
@@ -445,11 +453,21 @@ void TRestThread::StartProcess() {
 ///////////////////////////////////////////////
 /// \brief Create a thread with the method StartProcess().
 ///
-/// The thread will be detached afterwards.
+/// The thread is kept joinable. Call JoinThread() to wait for it to finish.
 void TRestThread::StartThread() {
+    if (t.joinable()) {
+        // after a fork the handle refers to the thread of the parent process, which does
+        // not exist in this one. It can neither be joined nor destroyed, only forgotten.
+        new (&t) thread();
+    }
     t = thread(&TRestThread::StartProcess, this);
-    t.detach();
-    // t.join();
+}
+
+///////////////////////////////////////////////
+/// \brief Waits until the thread created by StartThread() returns.
+///
+void TRestThread::JoinThread() {
+    if (t.joinable()) t.join();
 }
 
 ///////////////////////////////////////////////
@@ -484,6 +502,8 @@ void TRestThread::ProcessEvent() {
     TRestEvent* ProcessedEvent = fInputEvent;
     fProcessNullReturned = false;
 
+    for (auto& p : fProcessChain) p->SetInputEntry(fInputEntry);
+
     if (fVerboseLevel >= TRestStringOutput::REST_Verbose_Level::REST_Debug) {
 #ifdef TIME_MEASUREMENT
         vector<int> processtime(fProcessChain.size());
@@ -109,19 +109,19 @@ Bool_t TRestVolumeHits::areXYZ() const {
         return fType[0] == XYZ;
 }
 
-void TRestVolumeHits::MergeHits(Int_t n, Int_t m) {
-    Double_t totalEnergy = fEnergy[n] + fEnergy[m];
+///////////////////////////////////////////////
+/// \brief It merges the sigmas of hit `source` into hit `target`, weighted by their
+/// energies, and then the rest of the hit data. See TRestHits::MergeHitInto.
+///
+void TRestVolumeHits::MergeHitInto(size_t target, size_t source) {
+    Double_t totalEnergy = fEnergy[target] + fEnergy[source];
 
     // TODO : This is wrong but not very important for the moment
-    fSigmaX[n] = (fSigmaX[n] * fEnergy[n] + fSigmaX[m] * fEnergy[m]) / totalEnergy;
-    fSigmaY[n] = (fSigmaY[n] * fEnergy[n] + fSigmaY[m] * fEnergy[m]) / totalEnergy;
-    fSigmaZ[n] = (fSigmaZ[n] * fEnergy[n] + fSigmaZ[m] * fEnergy[m]) / totalEnergy;
-
-    fSigmaX.erase(fSigmaX.begin() + m);
-    fSigmaY.erase(fSigmaY.begin() + m);
-    fSigmaZ.erase(fSigmaZ.begin() + m);
+    fSigmaX[target] = (fSigmaX[target] * fEnergy[target] + fSigmaX[source] * fEnergy[source]) / totalEnergy;
+    fSigmaY[target] = (fSigmaY[target] * fEnergy[target] + fSigmaY[source] * fEnergy[source]) / totalEnergy;
+    fSigmaZ[target] = (fSigmaZ[target] * fEnergy[target] + fSigmaZ[source] * fEnergy[source]) / totalEnergy;
 
-    TRestHits::MergeHits(n, m);
+    TRestHits::MergeHitInto(target, source);
 }
 
 void TRestVolumeHits::RemoveHit(int n) {
@@ -132,14 +132,21 @@ void TRestVolumeHits::RemoveHit(int n) {
     fSigmaZ.erase(fSigmaZ.begin() + n);
 }
 
-void TRestVolumeHits::SortByEnergy() {
-    while (!isSortedByEnergy()) {
-        for (unsigned int i = 0; i < GetNumberOfHits(); i++) {
-            for (unsigned int j = i + 1; j < GetNumberOfHits(); j++) {
-                if (GetEnergy(i) < GetEnergy(j)) SwapHits(i, j);
-            }
-        }
+///////////////////////////////////////////////
+/// \brief It removes the hits flagged in `remove`, together with their sigmas. See
+/// TRestHits::RemoveHitsByMask.
+///
+void TRestVolumeHits::RemoveHitsByMask(const std::vector<Bool_t>& remove) {
+    if (remove.size() != GetNumberOfHits()) {
+        TRestHits::RemoveHitsByMask(remove);
+        return;
     }
+
+    RemoveFromColumn(fSigmaX, remove);
+    RemoveFromColumn(fSigmaY, remove);
+    RemoveFromColumn(fSigmaZ, remove);
+
+    TRestHits::RemoveHitsByMask(remove);
 }
 
 void TRestVolumeHits::SwapHits(Int_t i, Int_t j) {
@@ -150,6 +157,18 @@ void TRestVolumeHits::SwapHits(Int_t i, Int_t j) {
     TRestHits::SwapHits(i, j);
 }
 
+///////////////////////////////////////////////
+/// \brief It reorders the hits, together with their sigmas, following the permutation
+/// `order`. See TRestHits::ApplyPermutation.
+///
+void TRestVolumeHits::ApplyPermutation(const std::vector<size_t>& order) {
+    PermuteColumn(fSigmaX, order);
+    PermuteColumn(fSigmaY, order);
+    PermuteColumn(fSigmaZ, order);
+
+    TRestHits::ApplyPermutation(order);
+}
+
 TVector3 TRestVolumeHits::GetSigma(int n) const {
     return TVector3(((Double_t)fSigmaX[n]), ((Double_t)fSigmaY[n]), ((Double_t)fSigmaZ[n]));
 }
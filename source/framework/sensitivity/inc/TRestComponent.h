@@ -94,6 +94,12 @@ class TRestComponent : public TRestMetadata {
     /// A canvas for drawing the active node component
     TCanvas* fCanvas = nullptr;  //!
 
+    /// The parameterization node values sorted in ascending order together with their node index
+    std::vector<std::pair<Double_t, Int_t>> fSortedNodes;  //!
+
+    /// The total rate cached for each node density. A negative value means it must be recalculated
+    std::vector<Double_t> fNodeTotalRate;  //!
+
     Bool_t HasDensity() { return !fNodeDensity.empty(); }
 
     /// It returns true if the node has been properly identified
@@ -105,6 +111,9 @@ class TRestComponent : public TRestMetadata {
 
     Int_t GetVariableIndex(std::string varName);
 
+    void UpdateSortedNodes();
+    void InvalidateNodeCache(Int_t node = -1);
+
     void InitFromConfigFile() override;
 
     virtual void FillHistograms() = 0;
@@ -158,8 +167,14 @@ class TRestComponent : public TRestMetadata {
     void SetSamples(Int_t samples) { fSamples = samples; }
 
     Bool_t Interpolation() { return fInterpolation; }
-    void EnableInterpolation() { fInterpolation = true; }
-    void DisableInterpolation() { fInterpolation = false; }
+    void EnableInterpolation() {
+        fInterpolation = true;
+        InvalidateNodeCache();
+    }
+    void DisableInterpolation() {
+        fInterpolation = false;
+        InvalidateNodeCache();
+    }
 
     THnD* GetDensityForNode(Double_t value);
     THnD* GetDensityForActiveNode();
@@ -75,13 +75,13 @@ class TRestExperiment : public TRestMetadata {
     Bool_t IsMockData() const { return fMockData; }
     Bool_t IsDataReady() const { return fDataReady; }
 
-    void SetExposureInSeconds(const Double_t exposure) { fExposureTime = exposure / units("s"); }
+    void SetExposureInSeconds(const Double_t exposure) { fExposureTime = exposure / REST_Units::s; }
     void SetSignal(TRestComponent* comp) { fSignal = comp; }
     void SetBackground(TRestComponent* comp) { fBackground = comp; }
 
     void SetExperimentalDataSet(const std::string& filename);
 
-    Double_t GetExposureInSeconds() const { return fExposureTime * units("s"); }
+    Double_t GetExposureInSeconds() const { return fExposureTime * REST_Units::s; }
     TRestComponent* GetBackground() const { return fBackground; }
     TRestComponent* GetSignal() const { return fSignal; }
     TRestDataSet GetExperimentalDataSet() const { return fExperimentalData; }
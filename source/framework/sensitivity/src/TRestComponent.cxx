@@ -43,6 +43,7 @@
 #include <TKey.h>
 #include <TLatex.h>
 
+#include <algorithm>
 #include <numeric>
 
 ClassImp(TRestComponent);
@@ -113,6 +114,7 @@ void TRestComponent::Initialize() {
 ///
 void TRestComponent::RegenerateHistograms(UInt_t seed) {
     fNodeDensity.clear();
+    InvalidateNodeCache();
 
     fSeed = seed;
     FillHistograms();
@@ -142,6 +144,40 @@ void TRestComponent::RegenerateParametricNodes(Double_t from, Double_t to, Doubl
     RegenerateHistograms(fSeed);
 }
 
+///////////////////////////////////////////
+/// \brief It rebuilds the sorted list of node values used by
+/// TRestComponent::FindActiveNode to perform a binary search. The list is only
+/// rebuilt when it has been invalidated or the number of nodes changed.
+///
+void TRestComponent::UpdateSortedNodes() {
+    if (fSortedNodes.size() == fParameterizationNodes.size()) return;
+
+    fSortedNodes.clear();
+    fSortedNodes.reserve(fParameterizationNodes.size());
+    for (size_t n = 0; n < fParameterizationNodes.size(); n++)
+        fSortedNodes.push_back({fParameterizationNodes[n], (Int_t)n});
+
+    std::stable_sort(fSortedNodes.begin(), fSortedNodes.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+}
+
+///////////////////////////////////////////
+/// \brief It invalidates the cached total rate of the given node index. If no
+/// node is given (or it is negative) all the node caches, including the sorted
+/// node list, will be invalidated.
+///
+/// It must be called each time the node densities are modified.
+///
+void TRestComponent::InvalidateNodeCache(Int_t node) {
+    if (node >= 0) {
+        if (node < (Int_t)fNodeTotalRate.size()) fNodeTotalRate[node] = -1;
+        return;
+    }
+
+    fSortedNodes.clear();
+    fNodeTotalRate.clear();
+}
+
 ///////////////////////////////////////////
 /// \brief It returns the position of the fVariable element for the variable
 /// name given by argument.
@@ -324,10 +360,16 @@ Double_t TRestComponent::GetRawRate(std::vector<Double_t> point) {
 /// \brief This method integrates the rate to all the parameter space defined in the density function.
 /// The result will be returned in s-1.
 ///
+/// The integrated rate is cached for each node, and it will only be recalculated
+/// after the node density, the response or the interpolation settings change.
+///
 Double_t TRestComponent::GetTotalRate() {
     THnD* dHist = GetDensityForActiveNode();
     if (!dHist) return 0;
 
+    if (fNodeTotalRate.size() != fNodeDensity.size()) fNodeTotalRate.assign(fNodeDensity.size(), -1);
+    if (fNodeTotalRate[fActiveNode] >= 0) return fNodeTotalRate[fActiveNode];
+
     Double_t integral = 0;
     for (Int_t n = 0; n < dHist->GetNbins(); ++n) {
         Int_t centerBin[GetDimensions()];
@@ -343,6 +385,7 @@ Double_t TRestComponent::GetTotalRate() {
         if (!skip) integral += GetRate(point);
     }
 
+    fNodeTotalRate[fActiveNode] = integral;
     return integral;
 }
 
@@ -350,13 +393,19 @@ Double_t TRestComponent::GetTotalRate() {
 /// \brief This method returns the total rate for the node that has the highest contribution
 /// The result will be returned in s-1.
 ///
+/// The node total rates are cached, and the active node is preserved.
+///
 Double_t TRestComponent::GetMaxRate() {
+    Int_t activeNode = fActiveNode;
+
     Double_t maxRate = 0;
     for (size_t n = 0; n < fParameterizationNodes.size(); n++) {
         SetActiveNode((Int_t)n);
         Double_t rate = GetTotalRate();
         if (rate > maxRate) maxRate = rate;
     }
+
+    SetActiveNode(activeNode);
     return maxRate;
 }
 
@@ -364,12 +413,18 @@ Double_t TRestComponent::GetMaxRate() {
 /// \brief This method returns the integrated total rate for all the nodes
 /// The result will be returned in s-1.
 ///
+/// The node total rates are cached, and the active node is preserved.
+///
 Double_t TRestComponent::GetAllNodesIntegratedRate() {
+    Int_t activeNode = fActiveNode;
+
     Double_t rate = 0;
     for (size_t n = 0; n < fParameterizationNodes.size(); n++) {
         SetActiveNode((Int_t)n);
         rate += GetTotalRate();
     }
+
+    SetActiveNode(activeNode);
     return rate;
 }
 
@@ -602,6 +657,8 @@ void TRestComponent::LoadResponse(const TRestResponse& resp) {
     fResponse = (TRestResponse*)resp.Clone("response");
     if (fResponse) fResponse->LoadResponse();
 
+    InvalidateNodeCache();
+
     fResponse->PrintMetadata();
 }
 
@@ -716,19 +773,33 @@ void TRestComponent::InitFromConfigFile() {
 /// \brief It returns the position of the fParameterizationNodes
 /// element for the variable name given by argument.
 ///
+/// A node matches when its value is found within the relative precision
+/// defined by fPrecision. The nodes are searched using a binary search over
+/// a sorted copy of the node values. If several nodes fall inside the
+/// tolerance window, the closest one will be chosen.
+///
 Int_t TRestComponent::FindActiveNode(Double_t node) {
-    int n = 0;
-    for (const auto& v : fParameterizationNodes) {
-        Double_t pUp = node * (1 + fPrecision / 2);
-        Double_t pDown = node * (1 - fPrecision / 2);
-        if (v > pDown && v < pUp) {
-            fActiveNode = n;
-            return fActiveNode;
+    Double_t pUp = node * (1 + fPrecision / 2);
+    Double_t pDown = node * (1 - fPrecision / 2);
+    if (pDown >= pUp) return -1;
+
+    UpdateSortedNodes();
+
+    auto it = std::upper_bound(fSortedNodes.begin(), fSortedNodes.end(), pDown,
+                               [](Double_t value, const auto& p) { return value < p.first; });
+
+    Int_t found = -1;
+    Double_t minDist = 0;
+    for (; it != fSortedNodes.end() && it->first < pUp; ++it) {
+        Double_t dist = TMath::Abs(it->first - node);
+        if (found == -1 || dist < minDist) {
+            found = it->second;
+            minDist = dist;
         }
-        n++;
     }
 
-    return -1;
+    if (found >= 0) fActiveNode = found;
+    return found;
 }
 
 /////////////////////////////////////////////
@@ -736,16 +807,7 @@ Int_t TRestComponent::FindActiveNode(Double_t node) {
 /// element for the variable name given by argument.
 ///
 Int_t TRestComponent::SetActiveNode(Double_t node) {
-    int n = 0;
-    for (const auto& v : fParameterizationNodes) {
-        Double_t pUp = node * (1 + fPrecision / 2);
-        Double_t pDown = node * (1 - fPrecision / 2);
-        if (v > pDown && v < pUp) {
-            fActiveNode = n;
-            return fActiveNode;
-        }
-        n++;
-    }
+    if (FindActiveNode(node) >= 0) return fActiveNode;
 
     RESTError << "Parametric node : " << node << " was not found in component" << RESTendl;
     RESTError << "Keeping previous node as active : " << fParameterizationNodes[fActiveNode] << RESTendl;
@@ -758,13 +820,12 @@ Int_t TRestComponent::SetActiveNode(Double_t node) {
 /// \brief
 ///
 THnD* TRestComponent::GetDensityForNode(Double_t node) {
-    int n = 0;
-    for (const auto& x : fParameterizationNodes) {
-        if (x == node) {
-            return fNodeDensity[n];
-        }
-        n++;
-    }
+    UpdateSortedNodes();
+
+    auto it = std::lower_bound(fSortedNodes.begin(), fSortedNodes.end(), node,
+                               [](const auto& p, Double_t value) { return p.first < value; });
+    if (it != fSortedNodes.end() && it->first == node && it->second < (Int_t)fNodeDensity.size())
+        return fNodeDensity[it->second];
 
     RESTError << "Parametric node : " << node << " was not found in component" << RESTendl;
     PrintNodes();
@@ -302,6 +302,7 @@ void TRestComponentDataSet::FillHistograms() {
         fActiveNode = nIndex;
         nIndex++;
     }
+    InvalidateNodeCache();
 }
 
 /////////////////////////////////////////////
@@ -367,6 +368,7 @@ void TRestComponentDataSet::RegenerateActiveNodeDensity() {
     hNd->Scale(1. / fNSimPerNode[fActiveNode]);
 
     fNodeDensity[fActiveNode] = hNd;
+    InvalidateNodeCache(fActiveNode);
 }
 
 /////////////////////////////////////////////
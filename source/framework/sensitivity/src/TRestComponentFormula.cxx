@@ -205,6 +205,7 @@ void TRestComponentFormula::FillHistograms() {
     fNodeDensity.clear();
     fNodeDensity.push_back(hNd);
     fActiveNode = 0;  // For the moment only 1-node!
+    InvalidateNodeCache();
 }
 
 /////////////////////////////////////////////
@@ -101,7 +101,7 @@ void TRestExperiment::GenerateMockDataSet(Bool_t useAverage) {
         RESTError << "This time is required to create the mock dataset" << RESTendl;
     }
 
-    Double_t meanCounts = GetBackground()->GetTotalRate() * fExposureTime * units("s");
+    Double_t meanCounts = GetBackground()->GetTotalRate() * fExposureTime * REST_Units::s;
 
     Int_t N = fRandom->Poisson(meanCounts);
     if (fUseAverage) N = (Int_t)meanCounts;
@@ -110,7 +110,7 @@ void TRestExperiment::GenerateMockDataSet(Bool_t useAverage) {
     ROOT::RDF::RNode df = fBackground->GetMonteCarloDataFrame(N);
 
     fExperimentalData.SetDataFrame(df);
-    fExperimentalData.SetTotalTimeInSeconds(fExposureTime * units("s"));
+    fExperimentalData.SetTotalTimeInSeconds(fExposureTime * REST_Units::s);
 
     fExperimentalCounts = *fExperimentalData.GetDataFrame().Count();
 
@@ -123,7 +123,7 @@ void TRestExperiment::SetExperimentalDataSet(const std::string& filename) {
     fExperimentalData.Import(fExperimentalDataSet);
 
     /// fExposureTime is in standard REST units : us
-    fExposureTime = fExperimentalData.GetTotalTimeInSeconds() / units("s");
+    fExposureTime = fExperimentalData.GetTotalTimeInSeconds() / REST_Units::s;
     fExperimentalCounts = *fExperimentalData.GetDataFrame().Count();
 
     fMockData = false;
@@ -155,6 +155,9 @@ void TRestExperiment::SetExperimentalDataSet(const std::string& filename) {
 void TRestExperiment::InitFromConfigFile() {
     TRestMetadata::InitFromConfigFile();
 
+    // fExposureTime is read in REST units, it must be given in time units
+    CheckParameterUnits("exposureTime", "s");
+
     int cont = 0;
     TRestMetadata* md = (TRestMetadata*)this->InstantiateChildMetadata(cont);
     while (md != nullptr) {
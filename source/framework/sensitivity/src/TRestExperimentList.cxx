@@ -82,6 +82,9 @@ void TRestExperimentList::Initialize() { SetSectionName(this->ClassName()); }
 void TRestExperimentList::InitFromConfigFile() {
     TRestMetadata::InitFromConfigFile();
 
+    // fExposureTime is read in REST units, it must be given in time units
+    CheckParameterUnits("exposureTime", "s");
+
     if (!fExperimentsFile.empty() && fExperiments.empty()) {
         TRestTools::ReadASCIITable(fExperimentsFile, fExperimentsTable);
 
@@ -178,7 +181,7 @@ void TRestExperimentList::InitFromConfigFile() {
                 column++;
             } else {
                 if (ToLower(fExposureStrategy) == "unique") {
-                    experiment->SetExposureInSeconds(fExposureTime * units("s"));
+                    experiment->SetExposureInSeconds(fExposureTime * REST_Units::s);
                     // We will generate mock data once we load the background component
                     generateMockData = true;
                 }
@@ -227,7 +230,7 @@ void TRestExperimentList::InitFromConfigFile() {
             Double_t sum = 0;
             for (size_t n = 0; n < fExperiments.size(); n++) sum += TMath::Exp((double)n * fExposureFactor);
 
-            Double_t A = fExposureTime * units("s") / sum;
+            Double_t A = fExposureTime * REST_Units::s / sum;
             for (size_t n = 0; n < fExperiments.size(); n++) {
                 fExperiments[n]->SetExposureInSeconds(A * TMath::Exp((double)n * fExposureFactor));
                 fExperiments[n]->GenerateMockDataSet(fUseAverage);
@@ -240,7 +243,7 @@ void TRestExperimentList::InitFromConfigFile() {
             Double_t sum = 0;
             for (size_t n = 0; n < fExperiments.size(); n++) sum += TMath::Power((double)n, fExposureFactor);
 
-            Double_t A = fExposureTime * units("s") / sum;
+            Double_t A = fExposureTime * REST_Units::s / sum;
             for (size_t n = 0; n < fExperiments.size(); n++) {
                 fExperiments[n]->SetExposureInSeconds(A * TMath::Power((double)n, fExposureFactor));
                 fExperiments[n]->GenerateMockDataSet(fUseAverage);
@@ -251,7 +254,7 @@ void TRestExperimentList::InitFromConfigFile() {
             ExtractExperimentParameterizationNodes();
 
             for (size_t n = 0; n < fExperiments.size(); n++) {
-                fExperiments[n]->SetExposureInSeconds(fExposureTime * units("s") / fExperiments.size());
+                fExperiments[n]->SetExposureInSeconds(fExposureTime * REST_Units::s / fExperiments.size());
                 fExperiments[n]->GenerateMockDataSet(fUseAverage);
             }
         }
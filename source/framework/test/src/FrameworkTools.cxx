@@ -0,0 +1,157 @@
+
+#include <TRestStringHelper.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#if ROOT_VERSION_CODE < ROOT_VERSION(6, 0, 0)
+#include <TFormula.h>
+#else
+#include <v5/TFormula.h>
+#endif
+
+using namespace std;
+
+// The former implementations, used as reference for the faster ones replacing them
+namespace {
+// The dynamic programming matcher of REST_StringHelper::MatchString, without its 256
+// characters limit. It threw on an empty matcher, which only matches an empty string.
+bool ReferenceMatchString(const string& str, const string& matcher) {
+    if (matcher.empty()) return str.empty();
+    const size_t n1 = matcher.size();
+    const size_t n2 = str.size();
+    vector<vector<bool>> dp(n1 + 1, vector<bool>(n2 + 1));
+    dp[0][0] = true;
+    for (size_t i = 1; i <= n1 && matcher[i - 1] == '*'; i++) {
+        dp[i][0] = true;
+    }
+    for (size_t i = 1; i <= n1; i++) {
+        for (size_t j = 1; j <= n2; j++) {
+            if (matcher[i - 1] == '*') {
+                dp[i][j] = dp[i - 1][j - 1] || dp[i][j - 1] || dp[i - 1][j];
+            } else {
+                dp[i][j] = (matcher[i - 1] == '?' || matcher[i - 1] == str[j - 1]) && dp[i - 1][j - 1];
+            }
+        }
+    }
+    return dp[n1][n2];
+}
+
+// REST_StringHelper::EvaluateExpression, which always used TFormula
+string ReferenceEvaluateExpression(const string& exp) {
+    if (!REST_StringHelper::isAExpression(exp)) return exp;
+#if ROOT_VERSION_CODE < ROOT_VERSION(6, 0, 0)
+    TFormula formula("tmp", exp.c_str());
+#else
+    ROOT::v5::TFormula formula("tmp", exp.c_str());
+#endif
+    Double_t number = formula.EvalPar(0);
+    if (number > 0 && number < 1.e-300) return "RESTerror";
+    ostringstream sss;
+    sss << number;
+    return sss.str();
+}
+
+string RandomString(mt19937& random, const string& alphabet, size_t maxLength) {
+    string result(random() % (maxLength + 1), ' ');
+    for (auto& c : result) c = alphabet[random() % alphabet.size()];
+    return result;
+}
+}  // namespace
+
+TEST(FrameworkTools, MatchString) {
+    EXPECT_TRUE(REST_StringHelper::MatchString("abcddd", "abc??d"));
+    EXPECT_TRUE(REST_StringHelper::MatchString("abcddd", "abc*d"));
+    EXPECT_FALSE(REST_StringHelper::MatchString("abcddd", "abc?d"));
+    EXPECT_FALSE(REST_StringHelper::MatchString("abcddd", "a?c"));
+
+    // an empty matcher only matches an empty string
+    EXPECT_TRUE(REST_StringHelper::MatchString("", ""));
+    EXPECT_FALSE(REST_StringHelper::MatchString("a", ""));
+    EXPECT_TRUE(REST_StringHelper::MatchString("", "***"));
+    EXPECT_FALSE(REST_StringHelper::MatchString("", "?"));
+    EXPECT_TRUE(REST_StringHelper::WildcardPattern("").Match(""));
+    EXPECT_FALSE(REST_StringHelper::WildcardPattern("").Match("a"));
+
+    // strings longer than the 256 characters the former matcher accepted
+    const string longString(1000, 'a');
+    EXPECT_TRUE(REST_StringHelper::MatchString(longString + "b", "*a*b"));
+    EXPECT_FALSE(REST_StringHelper::MatchString(longString, "*a*b"));
+
+    mt19937 random(1);
+    for (int n = 0; n < 300000; n++) {
+        const string str = RandomString(random, "ab", 8);
+        const string matcher = RandomString(random, "ab*?", 6);
+        const bool expected = ReferenceMatchString(str, matcher);
+        EXPECT_EQ(REST_StringHelper::MatchString(str, matcher), expected) << str << " " << matcher;
+        EXPECT_EQ(REST_StringHelper::WildcardPattern(matcher).Match(str), expected) << str << " " << matcher;
+        // without classes nor leading dots, file names follow the same rules
+        EXPECT_EQ(REST_StringHelper::MatchFileName(str, matcher), expected) << str << " " << matcher;
+    }
+}
+
+TEST(FrameworkTools, MatchFileName) {
+    EXPECT_TRUE(REST_StringHelper::MatchFileName("run_00123.root", "run_*[0-9].root"));
+    EXPECT_TRUE(REST_StringHelper::MatchFileName("run_1.root", "run_[!a-c].root"));
+    EXPECT_FALSE(REST_StringHelper::MatchFileName("run_b.root", "run_[!a-c].root"));
+    EXPECT_TRUE(REST_StringHelper::MatchFileName("run_b.root", "run_[^a].root"));
+    EXPECT_TRUE(REST_StringHelper::MatchFileName("a]", "a[]]"));
+    // without the closing bracket "[" is a plain character
+    EXPECT_TRUE(REST_StringHelper::MatchFileName("a[", "a["));
+    EXPECT_FALSE(REST_StringHelper::MatchFileName("a1", "a[0-9"));
+
+    // a leading dot is only matched explicitly
+    EXPECT_FALSE(REST_StringHelper::MatchFileName(".hidden", "*"));
+    EXPECT_FALSE(REST_StringHelper::MatchFileName(".hidden", "?hidden"));
+    EXPECT_TRUE(REST_StringHelper::MatchFileName(".hidden", ".*"));
+    EXPECT_TRUE(REST_StringHelper::MatchFileName("a.b", "*.b"));
+
+    // MatchString has no classes
+    EXPECT_FALSE(REST_StringHelper::MatchString("a1", "a[0-9]"));
+    EXPECT_TRUE(REST_StringHelper::MatchString("a[0-9]", "a[0-9]"));
+}
+
+TEST(FrameworkTools, EvaluateExpression) {
+    const vector<string> expressions = {"1+1", "1/2", "3*(2+1)", "2-3-4", "12/3/2", "2^10", "1.5e3/4",
+                                        "-(2+3)*4", "-3+5", "sqrt(16)+1", "log10(1000)*2", "exp(1)",
+                                        "sin(0.5)", "cos(0)+1", "atan(1)*4", "2**3", "(1+2)*(3+4)/5",
+                                        "0.1+0.2",
+                                        // refused by the native evaluator, their precedence is left
+                                        // to TFormula
+                                        "-2^2", "2^3^2", "-2**2"};
+    for (const auto& expression : expressions) {
+        EXPECT_EQ(REST_StringHelper::EvaluateExpression(expression), ReferenceEvaluateExpression(expression))
+            << expression;
+        // the second evaluation comes from the cache
+        EXPECT_EQ(REST_StringHelper::EvaluateExpression(expression), ReferenceEvaluateExpression(expression))
+            << expression;
+    }
+
+    EXPECT_EQ(REST_StringHelper::EvaluateExpression("123"), "123");
+    EXPECT_EQ(REST_StringHelper::EvaluateExpression("./123"), "./123");
+}
+
+TEST(FrameworkTools, DiffString) {
+    EXPECT_EQ(REST_StringHelper::DiffString("woll ", "world"), 2);
+    EXPECT_EQ(REST_StringHelper::DiffString(string("kitten"), string("sitting"), 3), 3);
+    EXPECT_EQ(REST_StringHelper::DiffString(string("kitten"), string("sitting"), 2), 3);
+    EXPECT_EQ(REST_StringHelper::DiffString(string(""), string("abc"), 2), 3);
+    EXPECT_EQ(REST_StringHelper::DiffString(string(""), string(""), 0), 0);
+    EXPECT_EQ(REST_StringHelper::DiffString(string("abc"), string("abd"), 0), 1);
+    EXPECT_EQ(REST_StringHelper::DiffString(string("abc"), string("abd"), -1), 1);
+
+    mt19937 random(1);
+    // the bounds above 16 go through the full matrix
+    for (int maxDiff : {0, 1, 2, 3, 8, 15, 16, 17, 40}) {
+        for (int n = 0; n < 20000; n++) {
+            const string source = RandomString(random, "abc", 24);
+            const string target = RandomString(random, "abc", 24);
+            const int expected = min(REST_StringHelper::DiffString(source, target), maxDiff + 1);
+            EXPECT_EQ(REST_StringHelper::DiffString(string_view(source), string_view(target), maxDiff),
+                      expected)
+                << source << " " << target << " " << maxDiff;
+        }
+    }
+}
@@ -13,7 +13,12 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
 
 #include "Strlen.h"
 #include "TBuffer.h"
@@ -228,6 +233,73 @@ struct DataType_Info {
     }
 };
 
+/// Integer identifier of the type of a wrapped object. It is resolved once, when
+/// the object is wrapped, so that the operations done for each event do not
+/// compare type names.
+enum DataTypeTag : unsigned char {
+    kUnknownType = 0,
+    kCharType,
+    kShortType,
+    kIntType,
+    kLongType,
+    kLongLongType,
+    kBoolType,
+    kFloatType,
+    kDoubleType,
+    kLongDoubleType,
+    kUCharType,
+    kUShortType,
+    kUIntType,
+    kULongType,
+    kULongLongType,
+    kStringType,
+    kVectorIntType,
+    kVectorFloatType,
+    kVectorDoubleType,
+    kClassType,  //< any other class, told apart by its TClass
+    kNumberOfTypeTags
+};
+
+/// Get the type tag of a type, at compile time
+template <typename T>
+constexpr DataTypeTag GetTypeTag() {
+    if (std::is_same<T, char>::value) return kCharType;
+    if (std::is_same<T, short>::value) return kShortType;
+    if (std::is_same<T, int>::value) return kIntType;
+    if (std::is_same<T, long>::value) return kLongType;
+    if (std::is_same<T, long long>::value) return kLongLongType;
+    if (std::is_same<T, bool>::value) return kBoolType;
+    if (std::is_same<T, float>::value) return kFloatType;
+    if (std::is_same<T, double>::value) return kDoubleType;
+    if (std::is_same<T, long double>::value) return kLongDoubleType;
+    if (std::is_same<T, unsigned char>::value) return kUCharType;
+    if (std::is_same<T, unsigned short>::value) return kUShortType;
+    if (std::is_same<T, unsigned int>::value) return kUIntType;
+    if (std::is_same<T, unsigned long>::value) return kULongType;
+    if (std::is_same<T, unsigned long long>::value) return kULongLongType;
+    if (std::is_same<T, std::string>::value) return kStringType;
+    if (std::is_same<T, std::vector<int>>::value) return kVectorIntType;
+    if (std::is_same<T, std::vector<float>>::value) return kVectorFloatType;
+    if (std::is_same<T, std::vector<double>>::value) return kVectorDoubleType;
+    if (std::is_class<T>::value) return kClassType;
+    return kUnknownType;
+}
+
+/// Get the type tag of a type given by its type_info
+DataTypeTag GetTypeTag(const std::type_info* typeinfo, bool isClass);
+
+/// The operations on objects of a given type tag. Copy is nullptr for the types
+/// which must go through the registered converters.
+struct DataTypeOperations {
+    /// Copy the object at `from` to the object at `to`
+    void (*Copy)(const void* from, void* to);
+    /// The value of the object as double, nullptr if it is not a number
+    double (*ToDouble)(const void* obj);
+};
+
+/// Get the operations on objects of the given type tag
+const DataTypeOperations& GetTypeOperations(DataTypeTag tag);
+
 EXTERN_DEF std::map<void*, TClass*> RESTListOfClasses_typeid;
 EXTERN_DEF std::map<std::string, TClass*> RESTListOfClasses_typename;
 
@@ -305,6 +377,18 @@ class TRestReflector {
     TClass* cl = 0;
     /// Pointer to the corresponding TDataType helper, if the wrapped object is in data type
     bool is_data_type = false;
+    /// Type tag of the wrapped object, used to dispatch the operations without comparing type names
+    DataTypeTag tag = kUnknownType;
+    /// If the wrapped object has the same type as the one of `other`
+    bool IsSameType(const TRestReflector& other) const {
+        if (tag == kUnknownType || other.tag == kUnknownType) return type == other.type;
+        return tag == other.tag && (tag != kClassType || cl == other.cl);
+    }
+    /// The value of the wrapped object as double, NaN if it is not a number
+    double ToDouble() const {
+        auto toDouble = GetTypeOperations(tag).ToDouble;
+        return toDouble != nullptr ? toDouble(address) : std::numeric_limits<double>::quiet_NaN();
+    }
     /// If this object type wrapper is invalid
     bool IsZombie() const;
     /// Deep copy the content of the wrapped object to `to`.
@@ -397,6 +481,7 @@ class TRestReflector {
         }
 
         InitDictionary();
+        tag = GetTypeTag<T>();
     }
 };
 
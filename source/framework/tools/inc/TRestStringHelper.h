@@ -18,6 +18,7 @@
 #include <iostream>
 #include <set>
 #include <sstream>
+#include <string_view>
 
 #include "TRestStringOutput.h"
 
@@ -60,8 +61,24 @@ constexpr ULong64_t ToHash(const char* str, ULong64_t last_value = 0xCBF29CE4842
 }
 Int_t Count(std::string s, std::string sbstring);
 Int_t FindNthStringPosition(const std::string& in, size_t pos, const std::string& strToFind, size_t nth);
-Bool_t MatchString(std::string str, std::string matcher);
+Bool_t MatchString(const std::string& str, const std::string& matcher);
+Bool_t MatchFileName(const std::string& name, const std::string& pattern);
+
+/// A wildcard pattern, with "*" and "?", prepared to be matched against many strings
+class WildcardPattern {
+   public:
+    explicit WildcardPattern(const std::string& pattern);
+    Bool_t Match(const std::string& str) const;
+
+   private:
+    std::string fPattern;       // the pattern with consecutive "*" collapsed
+    bool fHasStar = false;      // if false, the pattern only matches strings of its size
+    size_t fPrefixLength = 0;   // characters before the first "*"
+    size_t fSuffixLength = 0;   // characters after the last "*"
+};
+
 Int_t DiffString(const std::string& source, const std::string& target);
+Int_t DiffString(std::string_view source, std::string_view target, Int_t maxDiff);
 template <class T>
 std::string ToString(T source, int length = -1, char fill = ' ') {
     std::stringstream ss1;
@@ -130,7 +130,7 @@ class TRestTools {
     static std::string GetPureFileName(const std::string& fullPathFileName);
     static std::string SearchFileInPath(std::vector<std::string> path, std::string filename);
     static bool CheckFileIsAccessible(const std::string&);
-    static std::vector<std::string> GetFilesMatchingPattern(std::string pattern, bool unlimited = false);
+    static std::vector<std::string> GetFilesMatchingPattern(std::string pattern, bool recursive = false);
     static int ConvertVersionCode(std::string in);
     static std::istream& GetLine(std::istream& is, std::string& t);
 
@@ -9,6 +9,83 @@
 using namespace std;
 
 namespace REST_Reflection {
+
+namespace {
+template <typename T>
+void CopyAs(const void* from, void* to) {
+    *(T*)to = *(const T*)from;
+}
+
+template <typename T>
+double ToDoubleAs(const void* obj) {
+    return (double)*(const T*)obj;
+}
+
+template <typename T>
+constexpr DataTypeOperations NumberOperations() {
+    return {&CopyAs<T>, &ToDoubleAs<T>};
+}
+
+template <typename T>
+constexpr DataTypeOperations ObjectOperations() {
+    return {&CopyAs<T>, nullptr};
+}
+
+// indexed by DataTypeTag
+const DataTypeOperations typeOperations[kNumberOfTypeTags] = {
+    {nullptr, nullptr},                      // kUnknownType
+    NumberOperations<char>(),                // kCharType
+    NumberOperations<short>(),               // kShortType
+    NumberOperations<int>(),                 // kIntType
+    NumberOperations<long>(),                // kLongType
+    NumberOperations<long long>(),           // kLongLongType
+    NumberOperations<bool>(),                // kBoolType
+    NumberOperations<float>(),               // kFloatType
+    NumberOperations<double>(),              // kDoubleType
+    NumberOperations<long double>(),         // kLongDoubleType
+    NumberOperations<unsigned char>(),       // kUCharType
+    NumberOperations<unsigned short>(),      // kUShortType
+    NumberOperations<unsigned int>(),        // kUIntType
+    NumberOperations<unsigned long>(),       // kULongType
+    NumberOperations<unsigned long long>(),  // kULongLongType
+    ObjectOperations<string>(),              // kStringType
+    ObjectOperations<vector<int>>(),         // kVectorIntType
+    ObjectOperations<vector<float>>(),       // kVectorFloatType
+    ObjectOperations<vector<double>>(),      // kVectorDoubleType
+    {nullptr, nullptr},                      // kClassType, cloned by the registered converter
+};
+}  // namespace
+
+DataTypeTag GetTypeTag(const type_info* typeinfo, bool isClass) {
+    if (typeinfo == nullptr) {
+        return isClass ? kClassType : kUnknownType;
+    }
+    const type_info& t = *typeinfo;
+    if (t == typeid(char)) return kCharType;
+    if (t == typeid(short)) return kShortType;
+    if (t == typeid(int)) return kIntType;
+    if (t == typeid(long)) return kLongType;
+    if (t == typeid(long long)) return kLongLongType;
+    if (t == typeid(bool)) return kBoolType;
+    if (t == typeid(float)) return kFloatType;
+    if (t == typeid(double)) return kDoubleType;
+    if (t == typeid(long double)) return kLongDoubleType;
+    if (t == typeid(unsigned char)) return kUCharType;
+    if (t == typeid(unsigned short)) return kUShortType;
+    if (t == typeid(unsigned int)) return kUIntType;
+    if (t == typeid(unsigned long)) return kULongType;
+    if (t == typeid(unsigned long long)) return kULongLongType;
+    if (t == typeid(string)) return kStringType;
+    if (t == typeid(vector<int>)) return kVectorIntType;
+    if (t == typeid(vector<float>)) return kVectorFloatType;
+    if (t == typeid(vector<double>)) return kVectorDoubleType;
+    return isClass ? kClassType : kUnknownType;
+}
+
+const DataTypeOperations& GetTypeOperations(DataTypeTag tag) {
+    return tag < kNumberOfTypeTags ? typeOperations[tag] : typeOperations[kUnknownType];
+}
+
 ////////////////////////////////////////////////////////////////
 ///
 /// Wrapper class for different type objects
@@ -70,6 +147,7 @@ TRestReflector::TRestReflector(void* _address, const string& _type) {
     type = cl == nullptr ? dt.name : cl->GetName();
 
     InitDictionary();
+    tag = GetTypeTag(typeinfo, cl != nullptr);
 }
 
 void TRestReflector::Assembly() {
@@ -124,7 +202,7 @@ void TRestReflector::PrintMemory(int bytepreline) {
 void TRestReflector::operator>>(const TRestReflector& to) { CloneAny(*this, to); }
 
 string TRestReflector::ToString() const {
-    if (type == "string") {
+    if (tag == kStringType) {
         return *(string*)(address);
     }
     if (address == nullptr) {
@@ -139,7 +217,7 @@ string TRestReflector::ToString() const {
 }
 
 void TRestReflector::ParseString(const string& str) const {
-    if (type == "string") {
+    if (tag == kStringType) {
         *(string*)(address) = str;
     } else {
         RESTVirtualConverter* converter = RESTConverterMethodBase[typeinfo->hash_code()];
@@ -250,6 +328,7 @@ int TRestReflector::InitDictionary() {
     RESTListOfClasses_typename.clear();
     cl = GetClassQuick(type);      // reset the TClass after loading external library.
     typeinfo = cl->GetTypeInfo();  // update the typeinfo
+    tag = GetTypeTag(typeinfo, true);
     return 0;
 }
 
@@ -271,12 +350,18 @@ void CloneAny(const TRestReflector& from, const TRestReflector& to) {
         return;
     }
 
-    if (from.type != to.type) {
+    if (!from.IsSameType(to)) {
         cout << "In TRestReflector::CloneTo() : type doesn't match! (This :" << from.type
              << ", Target : " << to.type << ")" << endl;
         return;
     }
 
+    const DataTypeOperations& operations = GetTypeOperations(from.tag);
+    if (operations.Copy != nullptr) {
+        operations.Copy(from.address, to.address);
+        return;
+    }
+
     RESTVirtualConverter* converter = RESTConverterMethodBase[from.typeinfo->hash_code()];
     if (converter != nullptr) {
         converter->CloneObj(from.address, to.address);
@@ -5,6 +5,11 @@
 #include <TSystem.h>
 #include <TTimer.h>
 
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 #if ROOT_VERSION_CODE < ROOT_VERSION(6, 0, 0)
 #include <TFormula.h>
 #else
@@ -30,7 +35,9 @@ Int_t REST_StringHelper::isAExpression(const string& in) {
     if (in.length() < 2)  // minimum expression: 3%
         return 0;
 
-    vector<string> funcs{"sqrt", "log", "exp", "gaus", "cos", "sin", "tan", "atan", "acos", "asin"};
+    // "atan", "acos" and "asin" go first, so that they are not seen as "a" + "tan"...
+    static const vector<string> funcs{"sqrt", "log",  "exp", "gaus", "atan",
+                                      "acos", "asin", "cos", "sin",  "tan"};
     for (const auto& item : funcs) {
         if (in.find(item) != string::npos) {
             symbol = true;
@@ -159,35 +166,186 @@ string REST_StringHelper::ReplaceMathematicalExpressions(string buffer, Int_t pr
     return result + unit;
 }
 
+namespace {
+// Recursive descent evaluator of the arithmetic expressions found in RML files: numbers,
+// + - * /, ^ or ** powers, parentheses and the functions in `functions`. It works in double
+// precision and refuses anything else, so that the caller can fall back to TFormula. The
+// constructs whose precedence may differ from TFormula, "-2^2" and "2^3^2", are refused too.
+class ExpressionParser {
+   public:
+    explicit ExpressionParser(const string& expression) : fExpression(expression) {}
+
+    bool Evaluate(Double_t& result) {
+        if (!ParseSum(result)) return false;
+        SkipSpaces();
+        return fPosition == fExpression.size() && std::isfinite(result);
+    }
+
+   private:
+    const string& fExpression;
+    size_t fPosition = 0;
+    bool fPowered = false;  // true if the last parsed operand was raised to a power
+
+    void SkipSpaces() {
+        while (fPosition < fExpression.size() && fExpression[fPosition] == ' ') fPosition++;
+    }
+
+    bool Accept(const char* token) {
+        SkipSpaces();
+        size_t length = strlen(token);
+        if (fExpression.compare(fPosition, length, token) != 0) return false;
+        fPosition += length;
+        return true;
+    }
+
+    bool ParseSum(Double_t& value) {
+        if (!ParseProduct(value)) return false;
+        Double_t operand;
+        while (true) {
+            if (Accept("+")) {
+                if (!ParseProduct(operand)) return false;
+                value += operand;
+            } else if (Accept("-")) {
+                if (!ParseProduct(operand)) return false;
+                value -= operand;
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool ParseProduct(Double_t& value) {
+        if (!ParseUnary(value)) return false;
+        Double_t operand;
+        while (true) {
+            if (Accept("*")) {
+                if (!ParseUnary(operand)) return false;
+                value *= operand;
+            } else if (Accept("/")) {
+                if (!ParseUnary(operand)) return false;
+                value /= operand;
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool ParseUnary(Double_t& value) {
+        bool negative = Accept("-");
+        if (!negative && !Accept("+")) return ParsePower(value);
+
+        if (!ParseUnary(value) || fPowered) return false;
+        if (negative) value = -value;
+        return true;
+    }
+
+    bool ParsePower(Double_t& value) {
+        if (!ParsePrimary(value)) return false;
+        fPowered = false;
+        if (!Accept("^") && !Accept("**")) return true;
+
+        Double_t exponent;
+        if (!ParseUnary(exponent) || fPowered) return false;
+        value = pow(value, exponent);
+        fPowered = true;
+        return true;
+    }
+
+    bool ParsePrimary(Double_t& value) {
+        SkipSpaces();
+        if (fPosition >= fExpression.size()) return false;
+
+        if (Accept("(")) {
+            return ParseSum(value) && Accept(")");
+        }
+
+        char c = fExpression[fPosition];
+        if (isalpha(c)) {
+            size_t start = fPosition;
+            while (fPosition < fExpression.size() && isalnum(fExpression[fPosition])) fPosition++;
+            auto function = functions.find(fExpression.substr(start, fPosition - start));
+            if (function == functions.end() || !Accept("(") || !ParseSum(value) || !Accept(")")) return false;
+            value = function->second(value);
+            return true;
+        }
+
+        // strtod would also read hexadecimal numbers, "inf" or "nan"
+        if (!isdigit(c) && c != '.') return false;
+        if (fExpression.compare(fPosition, 2, "0x") == 0 || fExpression.compare(fPosition, 2, "0X") == 0)
+            return false;
+        const char* start = fExpression.c_str() + fPosition;
+        char* end = nullptr;
+        value = strtod(start, &end);
+        if (end == start) return false;
+        fPosition += end - start;
+        return true;
+    }
+
+    static const map<string, Double_t (*)(Double_t)> functions;
+};
+
+const map<string, Double_t (*)(Double_t)> ExpressionParser::functions = {
+    {"sqrt", [](Double_t x) { return sqrt(x); }}, {"log", [](Double_t x) { return log(x); }},
+    {"log10", [](Double_t x) { return log10(x); }}, {"exp", [](Double_t x) { return exp(x); }},
+    {"sin", [](Double_t x) { return sin(x); }},   {"cos", [](Double_t x) { return cos(x); }},
+    {"tan", [](Double_t x) { return tan(x); }},   {"asin", [](Double_t x) { return asin(x); }},
+    {"acos", [](Double_t x) { return acos(x); }}, {"atan", [](Double_t x) { return atan(x); }},
+};
+
+// Results of EvaluateExpression, RML files repeat the same expressions many times
+constexpr size_t maxCachedExpressions = 100000;
+std::mutex expressionCacheMutex;
+std::unordered_map<string, string> expressionCache;
+}  // namespace
+
 ///////////////////////////////////////////////
 /// \brief Evaluates a complex numerical expression and returns the resulting
-/// value using TFormula.
+/// value.
+///
+/// The arithmetic operators `+ - * / ^`, parentheses and the functions `sqrt`, `log`,
+/// `log10`, `exp`, `sin`, `cos`, `tan`, `asin`, `acos` and `atan` are evaluated natively in
+/// double precision. Any other expression is evaluated using TFormula. The results are
+/// cached, so evaluating the same expression again is just a lookup. It is thread safe,
+/// as long as TFormula is not needed.
 ///
 string REST_StringHelper::EvaluateExpression(string exp) {
     if (!isAExpression(exp)) {
         return exp;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(expressionCacheMutex);
+        auto cached = expressionCache.find(exp);
+        if (cached != expressionCache.end()) return cached->second;
+    }
+
+    Double_t number;
+    if (!ExpressionParser(exp).Evaluate(number)) {
 // NOTE!!! In root6 the expression like "1/2" will be computed using the input
 // as int number, which will return 0, and cause problem. we roll back to
 // TFormula of version 5
 #if ROOT_VERSION_CODE < ROOT_VERSION(6, 0, 0)
-    TFormula formula("tmp", exp.c_str());
+        TFormula formula("tmp", exp.c_str());
 #else
-    ROOT::v5::TFormula formula("tmp", exp.c_str());
+        ROOT::v5::TFormula formula("tmp", exp.c_str());
 #endif
 
-    ostringstream sss;
-    Double_t number = formula.EvalPar(0);
-    if (number > 0 && number < 1.e-300) {
-        RESTWarning << "REST_StringHelper::EvaluateExpresssion. Expression not recognized --> " << exp
-                    << RESTendl;
-        return (string) "RESTerror";
+        number = formula.EvalPar(0);
+        if (number > 0 && number < 1.e-300) {
+            RESTWarning << "REST_StringHelper::EvaluateExpresssion. Expression not recognized --> " << exp
+                        << RESTendl;
+            return (string) "RESTerror";
+        }
     }
 
+    ostringstream sss;
     sss << number;
     string out = sss.str();
 
+    std::lock_guard<std::mutex> lock(expressionCacheMutex);
+    if (expressionCache.size() >= maxCachedExpressions) expressionCache.clear();
+    expressionCache.emplace(exp, out);
+
     return out;
 }
 
@@ -360,6 +518,60 @@ Int_t REST_StringHelper::FindNthStringPosition(const string& in, size_t pos, con
     return FindNthStringPosition(in, found_pos + 1, strToFind, nth - 1);
 }
 
+namespace {
+// It returns the position after the pattern token at `j` ("?", a "[...]" class if `classes`
+// is set, or a plain character) if it matches `c`, or string::npos if it does not
+size_t MatchToken(const char* pattern, size_t patternLength, size_t j, char c, bool classes) {
+    if (pattern[j] == '?') return j + 1;
+    if (!classes || pattern[j] != '[') return pattern[j] == c ? j + 1 : string::npos;
+
+    size_t k = j + 1;
+    bool negated = k < patternLength && (pattern[k] == '!' || pattern[k] == '^');
+    if (negated) k++;
+    bool found = false;
+    // a "]" just after the opening bracket is a member of the class
+    for (size_t first = k; k < patternLength && (pattern[k] != ']' || k == first);) {
+        if (k + 2 < patternLength && pattern[k + 1] == '-' && pattern[k + 2] != ']') {
+            found |= pattern[k] <= c && c <= pattern[k + 2];
+            k += 3;
+        } else {
+            found |= pattern[k] == c;
+            k++;
+        }
+    }
+    // without a closing bracket the "[" is a plain character
+    if (k >= patternLength) return c == '[' ? j + 1 : string::npos;
+    return found != negated ? k + 1 : string::npos;
+}
+
+// Greedy wildcard matching. On a mismatch it only backtracks to the last "*", letting it
+// absorb one more character, so it needs no memory and runs in linear time for the usual
+// patterns (quadratic in the worst case).
+bool MatchWildcards(const char* str, size_t strLength, const char* pattern, size_t patternLength,
+                    bool classes = false) {
+    size_t i = 0, j = 0;
+    size_t star = string::npos, starMatch = 0;
+    while (i < strLength) {
+        size_t next = string::npos;
+        if (j < patternLength && pattern[j] == '*') {
+            star = j++;
+            starMatch = i;
+        } else if (j < patternLength &&
+                   (next = MatchToken(pattern, patternLength, j, str[i], classes)) != string::npos) {
+            i++;
+            j = next;
+        } else if (star != string::npos) {
+            j = star + 1;
+            i = ++starMatch;
+        } else {
+            return false;
+        }
+    }
+    while (j < patternLength && pattern[j] == '*') j++;
+    return j == patternLength;
+}
+}  // namespace
+
 /// \brief This method matches a string with certain matcher. Returns true if matched.
 /// Supports wildcard characters.
 ///
@@ -375,51 +587,74 @@ Int_t REST_StringHelper::FindNthStringPosition(const string& in, size_t pos, con
 /// "abcddd", "abcddd" --> matched
 /// "abcddd", "a?c" --> not matched
 ///
-/// Source code from
-/// https://blog.csdn.net/dalao_whs/article/details/110477705
+/// It allocates no memory and has no limit on the string sizes. To match many strings
+/// against the same matcher, REST_StringHelper::WildcardPattern is faster.
 ///
-Bool_t REST_StringHelper::MatchString(string str, string matcher) {
-    if (str.size() > 256 || matcher.size() > 256) {
-        RESTError << "REST_StringHelper::MatchString(): string size too large" << RESTendl;
-        return false;
+Bool_t REST_StringHelper::MatchString(const string& str, const string& matcher) {
+    return MatchWildcards(str.data(), str.size(), matcher.data(), matcher.size());
+}
+
+///////////////////////////////////////////////
+/// \brief It matches a file name against one path component of a shell glob. Returns true
+/// if matched.
+///
+/// Besides "*" and "?", as in MatchString, it supports character classes as "[0-9]", "[abc]"
+/// or "[!a]". As in the shell, a name starting with "." is only matched by a pattern that
+/// also starts with ".".
+///
+Bool_t REST_StringHelper::MatchFileName(const string& name, const string& pattern) {
+    if (!name.empty() && name[0] == '.' && (pattern.empty() || pattern[0] != '.')) return false;
+    return MatchWildcards(name.data(), name.size(), pattern.data(), pattern.size(), true);
+}
+
+///////////////////////////////////////////////
+/// \brief It prepares `pattern` to be matched against many strings with Match.
+///
+/// Consecutive "*" are collapsed, and the characters before the first "*" and after the
+/// last one are kept apart, so that they are compared directly at both ends of the
+/// string before any backtracking.
+///
+REST_StringHelper::WildcardPattern::WildcardPattern(const string& pattern) {
+    for (char c : pattern) {
+        if (c != '*' || fPattern.empty() || fPattern.back() != '*') fPattern += c;
     }
 
-    vector<vector<bool>> dp(256, vector<bool>(256));
-    int n2 = str.size();
-    int n1 = matcher.size();
-    dp[0][0] = true;
-    int i = 0, j = 0;
-    for (int i = 0; i < n1; i++) {
-        if (matcher[i] != '*') {
-            break;
-        }
-        if (i == n1 - 1 && matcher[i] == '*') {
-            return true;
-        }
+    size_t firstStar = fPattern.find('*');
+    fHasStar = firstStar != string::npos;
+    if (fHasStar) {
+        fPrefixLength = firstStar;
+        fSuffixLength = fPattern.size() - fPattern.rfind('*') - 1;
     }
-    for (i = 1; matcher.at(i - 1) == '*'; i++) {
-        dp[i][0] = true;
-    }
-    for (i = 1; i <= n1; i++) {
-        for (j = 1; j <= n2; j++) {
-            if (matcher.at(i - 1) == '*' && (dp[i - 1][j - 1] || dp[i][j - 1] || dp[i - 1][j])) {
-                dp[i][j] = true;
-            } else if (matcher.at(i - 1) == '?' && dp[i - 1][j - 1]) {
-                dp[i][j] = true;
-            } else if (matcher.at(i - 1) == str.at(j - 1) && dp[i - 1][j - 1]) {
-                dp[i][j] = true;
-            }
+}
+
+///////////////////////////////////////////////
+/// \brief It returns true if `str` matches the pattern, with the same logic as
+/// REST_StringHelper::MatchString.
+///
+Bool_t REST_StringHelper::WildcardPattern::Match(const string& str) const {
+    auto matchFixed = [](const char* s, const char* p, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            if (p[i] != '?' && p[i] != s[i]) return false;
         }
-    }
-    if (dp[n1][n2]) {
         return true;
-    } else {
-        return false;
+    };
+
+    if (!fHasStar) {
+        return str.size() == fPattern.size() && matchFixed(str.data(), fPattern.data(), fPattern.size());
     }
 
-    return false;
+    if (str.size() < fPrefixLength + fSuffixLength) return false;
+    if (!matchFixed(str.data(), fPattern.data(), fPrefixLength)) return false;
+    if (!matchFixed(str.data() + str.size() - fSuffixLength,
+                    fPattern.data() + fPattern.size() - fSuffixLength, fSuffixLength))
+        return false;
+
+    // the middle of the pattern starts and ends with "*"
+    return MatchWildcards(str.data() + fPrefixLength, str.size() - fPrefixLength - fSuffixLength,
+                          fPattern.data() + fPrefixLength, fPattern.size() - fPrefixLength - fSuffixLength);
 }
 
+///////////////////////////////////////////////
 /// \brief Returns the number of different characters between two strings
 ///
 /// This algorithm is case insensitive. It matches the two strings in pieces
@@ -478,6 +713,62 @@ Int_t REST_StringHelper::DiffString(const string& source, const string& target)
     return matrix[n][m];
 }
 
+///////////////////////////////////////////////
+/// \brief Returns the edit distance between two strings, if it is not larger than **maxDiff**
+///
+/// Otherwise it returns maxDiff + 1. Only the cells of the matrix within maxDiff of its diagonal
+/// are computed, and it stops as soon as a full row exceeds maxDiff. It is meant to look for
+/// misspellings among many names:
+///
+/// \code
+/// if (DiffString(name, candidate, 2) <= 2) { ... }
+/// \endcode
+///
+/// No memory is allocated for maxDiff up to 16.
+///
+Int_t REST_StringHelper::DiffString(std::string_view source, std::string_view target, Int_t maxDiff) {
+    const int n = source.size();
+    const int m = target.size();
+    const int k = std::max(maxDiff, 0);
+    const int outOfRange = k + 1;
+    if (abs(n - m) > k) return outOfRange;
+
+    constexpr int maxBand = 16;
+    if (k > maxBand) {
+        return min(DiffString(string(source), string(target)), outOfRange);
+    }
+
+    // row[d] holds the cell (i, j = i + d - k) of the matrix, capped at outOfRange
+    int previous[2 * maxBand + 1];
+    int current[2 * maxBand + 1];
+    const int width = 2 * k + 1;
+    for (int d = 0; d < width; d++) {
+        const int j = d - k;
+        previous[d] = (j < 0 || j > m) ? outOfRange : min(j, outOfRange);
+    }
+
+    for (int i = 1; i <= n; i++) {
+        int rowMin = outOfRange;
+        for (int d = 0; d < width; d++) {
+            const int j = i + d - k;
+            int value = outOfRange;
+            if (j == 0) {
+                value = i;
+            } else if (j > 0 && j <= m) {
+                value = previous[d] + (source[i - 1] == target[j - 1] ? 0 : 1);
+                if (d + 1 < width) value = min(value, previous[d + 1] + 1);
+                if (d > 0) value = min(value, current[d - 1] + 1);
+            }
+            current[d] = min(value, outOfRange);
+            rowMin = min(rowMin, current[d]);
+        }
+        if (rowMin == outOfRange) return outOfRange;
+        std::copy(current, current + width, previous);
+    }
+
+    return previous[m - n + k];
+}
+
 ///////////////////////////////////////////////
 /// \brief Replace any occurences of **thisSring** by **byThisString** inside
 /// string **in**.
@@ -877,8 +877,9 @@ std::set<std::string> TRestTools::GetMatchingStrings(const std::vector<std::stri
     std::set<std::string> result;
     for (auto& ws : wantedStrings) {
         if (ws.find("*") != std::string::npos || ws.find("?") != std::string::npos) {
+            WildcardPattern pattern(ws);
             for (auto& c : stack)
-                if (MatchString(c, ws)) result.insert(c);
+                if (pattern.Match(c)) result.insert(c);
         } else if (std::find(stack.begin(), stack.end(), ws) != stack.end())
             result.insert(ws);
     }
@@ -1016,67 +1017,131 @@ bool TRestTools::CheckFileIsAccessible(const std::string& filename) {
     return true;
 }
 
+namespace {
+namespace fs = std::filesystem;
+
+bool HasGlobCharacters(const string& pattern) { return pattern.find_first_of("*?[") != string::npos; }
+
+// It calls `function(entry, path)` for each entry of `directory`, the current directory if it
+// is empty, being `path` the entry path as `directory`/name
+template <typename F>
+void ForEachEntry(const fs::path& directory, F&& function) {
+    std::error_code error;
+    fs::directory_iterator it(directory.empty() ? fs::path(".") : directory,
+                              fs::directory_options::skip_permission_denied, error);
+    for (; !error && it != fs::directory_iterator(); it.increment(error)) {
+        function(*it, directory / it->path().filename());
+    }
+}
+
+// It adds to `files` the regular files at any depth below `directory` whose name matches `pattern`
+void FindFilesRecursively(const fs::path& directory, const string& pattern, vector<string>& files) {
+    std::error_code error;
+    fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error);
+    for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+        std::error_code typeError;
+        if (it->is_regular_file(typeError) && MatchFileName(it->path().filename().string(), pattern)) {
+            files.push_back(it->path().string());
+        }
+    }
+}
+
+// It expands a glob pattern with wildcards in any of its path components, and returns the
+// matching regular files sorted by name
+vector<string> ExpandGlob(const string& pattern, bool recursive) {
+    fs::path path(pattern);
+    fs::path relativePath = path.relative_path();
+    vector<fs::path> components(relativePath.begin(), relativePath.end());
+    if (components.empty()) return {};
+    string filePattern = components.back().string();
+    components.pop_back();
+
+    // the directories matching all but the last component
+    vector<fs::path> directories = {path.root_path()};
+    for (const auto& component : components) {
+        string name = component.string();
+        vector<fs::path> matching;
+        for (const auto& directory : directories) {
+            std::error_code error;
+            // a name with glob characters is taken literally if such a directory exists
+            if (fs::is_directory(directory / component, error)) {
+                matching.push_back(directory / component);
+                continue;
+            }
+            if (!HasGlobCharacters(name)) continue;
+            ForEachEntry(directory, [&](const fs::directory_entry& entry, const fs::path& entryPath) {
+                if (entry.is_directory(error) && MatchFileName(entryPath.filename().string(), name)) {
+                    matching.push_back(entryPath);
+                }
+            });
+        }
+        directories.swap(matching);
+    }
+
+    vector<string> files;
+    vector<fs::path> subdirectories;
+    for (const auto& directory : directories) {
+        std::error_code error;
+        if (!recursive && fs::is_regular_file(directory / filePattern, error)) {
+            files.push_back((directory / filePattern).string());
+            continue;
+        }
+        if (!recursive && !HasGlobCharacters(filePattern)) continue;
+        ForEachEntry(directory, [&](const fs::directory_entry& entry, const fs::path& entryPath) {
+            if (entry.is_regular_file(error)) {
+                string fileName = entryPath.filename().string();
+                if (MatchFileName(fileName, filePattern)) files.push_back(entryPath.string());
+            } else if (recursive && !entry.is_symlink(error) && entry.is_directory(error)) {
+                subdirectories.push_back(entryPath);
+            }
+        });
+    }
+
+    // the subdirectory trees are walked in parallel, each thread taking one out of `nThreads`
+    size_t nThreads = min<size_t>(subdirectories.size(), max(1u, thread::hardware_concurrency()));
+    vector<vector<string>> found(nThreads);
+    vector<thread> threads;
+    for (size_t t = 0; t < nThreads; t++) {
+        threads.emplace_back([&, t]() {
+            for (size_t n = t; n < subdirectories.size(); n += nThreads) {
+                FindFilesRecursively(subdirectories[n], filePattern, found[t]);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (const auto& f : found) files.insert(files.end(), f.begin(), f.end());
+
+    sort(files.begin(), files.end());
+    return files;
+}
+}  // namespace
+
 ///////////////////////////////////////////////
-/// \brief Returns a list of files whose name match the pattern string. Key word
-/// is "*". e.g. abc00*.root
+/// \brief Returns a list of files whose name match the pattern string. e.g. abc00*.root
+///
+/// The wildcards "*", "?" and character classes as "[0-9]" or "[!a]" may appear in any
+/// component of the path, e.g. /data/run_*/R0[0-4]*.root. Names starting with "." are only
+/// matched explicitly, as in the shell. A pattern, or a path component, naming an existing
+/// file or directory is taken literally, so that a file named e.g. run[1].root is found.
+/// Several patterns may be given separated by "\n". The files matching each pattern are
+/// sorted by name.
+///
+/// If `recursive` is true, the file name part of the pattern is also searched in all the
+/// subdirectories of the matching directories, walked in parallel, as `find -name` does.
 ///
-/// Argument unlimited will fix an issue with the number of files being to high.
-/// However, it causes issues when searching/listing the macros.
-/// The default value for unlimited is `false`.
+/// The directories are read in-process, without running any command or changing the
+/// working directory, so it can be called from several threads.
 ///
-vector<string> TRestTools::GetFilesMatchingPattern(string pattern, bool unlimited) {
+vector<string> TRestTools::GetFilesMatchingPattern(string pattern, bool recursive) {
     std::vector<string> outputFileNames;
     if (pattern != "") {
         vector<string> items = Split(pattern, "\n");
         for (auto item : items) {
-            if (item.find_first_of("*?") != string::npos) {
-#ifdef WIN32
-                item = Replace(item, "/", "\\");
-                string item_trim =
-                    item.substr(0, item.find_first_of("*?"));  // trim string to before wildcard character
-                auto path_name = SeparatePathAndName(item_trim);
-                string _path = path_name.first;
-                if (!std::filesystem::exists(_path)) {
-                    RESTError << "TRestTools::GetFilesMatchingPattern(): path " << _path << " does not exist!"
-                              << RESTendl;
-                    return outputFileNames;
-                }
-
-                std::filesystem::path path(_path);
-                std::filesystem::recursive_directory_iterator iter(path);
-                for (auto& it : iter) {
-                    if (it.is_regular_file()) {
-                        string filename = it.path().string();
-                        if (MatchString(filename, item)) {
-                            outputFileNames.push_back(it.path().string());
-                        }
-                    }
-                }
-#else
-                auto path_name = SeparatePathAndName(item);
-                if (unlimited) {
-                    std::string currentDir = filesystem::current_path();
-                    ChangeDirectory(path_name.first);
-                    string a = Execute("find -type f -name \'" + path_name.second + "\'");
-                    ChangeDirectory(currentDir);
-                    auto b = Split(a, "\n");
-
-                    for (unsigned int i = 0; i < b.size(); i++) {
-                        outputFileNames.push_back(path_name.first + "/" + b[i]);
-                    }
-
-                } else {
-                    string a = Execute("find " + item);
-                    auto b = Split(a, "\n");
-
-                    for (unsigned int i = 0; i < b.size(); i++) {
-                        outputFileNames.push_back(b[i]);
-                    }
-                }
-#endif
-
-            } else {
-                if (fileExists(item)) outputFileNames.push_back(item);
+            if (fileExists(item)) {
+                outputFileNames.push_back(item);
+            } else if (HasGlobCharacters(item)) {
+                vector<string> files = ExpandGlob(item, recursive);
+                outputFileNames.insert(outputFileNames.end(), files.begin(), files.end());
             }
         }
     }